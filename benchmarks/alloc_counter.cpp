@@ -0,0 +1,31 @@
+#include "alloc_counter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+  std::atomic_size_t allocations{0};
+}
+
+auto bench::allocation_count() -> usize {
+  return allocations.load(std::memory_order_relaxed);
+}
+
+auto operator new(const std::size_t size) -> void* {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+
+  throw std::bad_alloc{};
+}
+
+auto operator delete(void* ptr) noexcept -> void {
+  std::free(ptr);
+}
+
+auto operator delete(void* ptr, std::size_t) noexcept -> void {
+  std::free(ptr);
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <crab/num/integer.hpp>
+
+namespace bench {
+  /// Total number of calls to global operator new made by this process.
+  [[nodiscard]] auto allocation_count() -> usize;
+
+  /// Counts how many allocations are made by invoking the given function.
+  template<typename F>
+  [[nodiscard]] auto count_allocations(F&& function) -> usize {
+    const usize before{allocation_count()};
+    function();
+    return allocation_count() - before;
+  }
+}
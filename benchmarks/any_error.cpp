@@ -0,0 +1,87 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <vector>
+#include <crab/preamble.hpp>
+
+#include "alloc_counter.hpp"
+
+namespace {
+  constexpr usize calls{10'000};
+
+  /// Small error of an RPC call, its message is only put together if it is asked for
+  class CallError final : public crab::IError {
+  public:
+
+    CallError(const u32 status, const u32 request): status{status}, request{request} {}
+
+    [[nodiscard]] auto what() const -> String override {
+      return fmt::format("request {} failed with status {}", request, status);
+    }
+
+  private:
+
+    u32 status;
+    u32 request;
+  };
+
+  /// Request ids, 30% of which fail
+  auto make_input() -> std::vector<u32> {
+    std::vector<u32> input;
+    input.reserve(calls);
+
+    for (usize i = 0; i < calls; i++) {
+      input.push_back(static_cast<u32>(i));
+    }
+
+    return input;
+  }
+
+  auto call_boxed(const u32 request) -> Result<u32, Box<crab::IError>> {
+    if (request % 10 < 3) {
+      return Box<crab::IError>{crab::make_box<CallError>(503, request)};
+    }
+    return request * 2;
+  }
+
+  auto call_any(const u32 request) -> Result<u32, AnyError> {
+    if (request % 10 < 3) {
+      return crab::make_any_error<CallError>(503, request);
+    }
+    return request * 2;
+  }
+
+  template<typename F>
+  auto succeeded_total(const std::vector<u32>& input, F&& call) -> u64 {
+    u64 total{0};
+    for (const u32 request: input) {
+      auto result{call(request)};
+      if (result.is_ok()) {
+        total += crab::move(result).unwrap();
+      }
+    }
+    return total;
+  }
+}
+
+TEST_CASE("Type erased errors", "[result][error][benchmark]") {
+  const std::vector<u32> input{make_input()};
+
+  REQUIRE(succeeded_total(input, call_boxed) == succeeded_total(input, call_any));
+
+  WARN(
+    "Box<IError> allocations: "
+    << bench::count_allocations([&] { crab::discard(succeeded_total(input, call_boxed)); })
+  );
+  WARN("AnyError allocations: " << bench::count_allocations([&] { crab::discard(succeeded_total(input, call_any)); }));
+  WARN("sizeof(Result<u32, Box<IError>>): " << sizeof(Result<u32, Box<crab::IError>>));
+  WARN("sizeof(Result<u32, AnyError>): " << sizeof(Result<u32, AnyError>));
+
+  BENCHMARK("Box<IError>") {
+    return succeeded_total(input, call_boxed);
+  };
+
+  BENCHMARK("AnyError") {
+    return succeeded_total(input, call_any);
+  };
+}
@@ -0,0 +1,188 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <algorithm>
+#include <utility>
+#include <variant>
+#include <vector>
+#include <crab/preamble.hpp>
+
+namespace {
+  constexpr usize value_count{10'000};
+
+  /// Distinct alternative, the weight keeps every visitor instantiation different
+  template<usize I>
+  struct Alternative {
+    static constexpr u64 weight{I + 1};
+
+    u64 value;
+  };
+
+  template<template<typename...> typename Sum, typename Indices>
+  struct SumOfImpl;
+
+  template<template<typename...> typename Sum, usize... Is>
+  struct SumOfImpl<Sum, std::index_sequence<Is...>> {
+    using type = Sum<Alternative<Is>...>;
+  };
+
+  /// Sum type (AnyOf or std::variant) of N distinct alternatives
+  template<template<typename...> typename Sum, usize N>
+  using SumOf = SumOfImpl<Sum, std::make_index_sequence<N>>::type;
+
+  /// Fills a list with alternatives in a fixed pseudo random order, so the branch predictor cannot learn it
+  template<typename Sum, usize N>
+  auto make_values() -> std::vector<Sum> {
+    std::vector<Sum> values;
+    values.reserve(value_count);
+
+    u64 state{0x9E37'79B9'7F4A'7C15};
+    for (usize i = 0; i < value_count; i++) {
+      state ^= state << 13;
+      state ^= state >> 7;
+      state ^= state << 17;
+
+      [&]<usize... Is>(std::index_sequence<Is...>) {
+        const usize index{state % N};
+        crab::discard(((index == Is ? (values.emplace_back(Alternative<Is>{i}), true) : false) or ...));
+      }(std::make_index_sequence<N>{});
+    }
+
+    return values;
+  }
+
+  constexpr auto weigh = []<usize I>(const Alternative<I>& alternative) -> u64 {
+    return alternative.value * Alternative<I>::weight;
+  };
+
+  template<usize N>
+  auto compare() -> void {
+    using CrabSum = SumOf<AnyOf, N>;
+    using StdSum = SumOf<std::variant, N>;
+
+    const std::vector<CrabSum> crab_values = make_values<CrabSum, N>();
+    const std::vector<StdSum> std_values = make_values<StdSum, N>();
+
+    const auto crab_visit = [&] {
+      u64 sum{0};
+      for (const auto& value: crab_values) {
+        sum += value.visit(weigh);
+      }
+      return sum;
+    };
+
+    const auto std_visit = [&] {
+      u64 sum{0};
+      for (const auto& value: std_values) {
+        sum += std::visit(weigh, value);
+      }
+      return sum;
+    };
+
+    REQUIRE(crab_visit() == std_visit());
+
+    BENCHMARK("AnyOf::visit") {
+      return crab_visit();
+    };
+
+    BENCHMARK("std::visit") {
+      return std_visit();
+    };
+
+    BENCHMARK("AnyOf copy") {
+      return std::vector<CrabSum>(crab_values).size();
+    };
+
+    BENCHMARK("std::variant copy") {
+      return std::vector<StdSum>(std_values).size();
+    };
+  }
+}
+
+TEST_CASE("AnyOf visit (2 alternatives)", "[any][benchmark]") {
+  compare<2>();
+}
+
+TEST_CASE("AnyOf visit (8 alternatives)", "[any][benchmark]") {
+  compare<8>();
+}
+
+TEST_CASE("AnyOf visit (64 alternatives)", "[any][benchmark]") {
+  compare<64>();
+}
+
+TEST_CASE("AnyOf multi visit (8 x 8 alternatives)", "[any][benchmark]") {
+  using Sum = SumOf<AnyOf, 8>;
+
+  const std::vector<Sum> lhs = make_values<Sum, 8>();
+  std::vector<Sum> rhs = make_values<Sum, 8>();
+  std::ranges::reverse(rhs);
+
+  constexpr auto combine = []<usize I, usize J>(const Alternative<I>& a, const Alternative<J>& b) -> u64 {
+    return a.value * Alternative<I>::weight + b.value * Alternative<J>::weight * I;
+  };
+
+  const auto nested = [&] {
+    u64 sum{0};
+    for (usize i = 0; i < lhs.size(); i++) {
+      sum += lhs[i].visit([&](const auto& a) { return rhs[i].visit([&](const auto& b) { return combine(a, b); }); });
+    }
+    return sum;
+  };
+
+  const auto flattened = [&] {
+    u64 sum{0};
+    for (usize i = 0; i < lhs.size(); i++) {
+      sum += crab::any::visit(combine, lhs[i], rhs[i]);
+    }
+    return sum;
+  };
+
+  REQUIRE(nested() == flattened());
+
+  BENCHMARK("nested AnyOf::visit") {
+    return nested();
+  };
+
+  BENCHMARK("crab::any::visit") {
+    return flattened();
+  };
+}
+
+TEST_CASE("VariantVec for_each_of (8 alternatives)", "[any][benchmark]") {
+  using Sum = SumOf<AnyOf, 8>;
+
+  const std::vector<Sum> values = make_values<Sum, 8>();
+
+  const auto partitioned = [&]<usize... Is>(std::index_sequence<Is...>) {
+    VariantVec<Alternative<Is>...> partitioned;
+    for (const Sum& value: values) {
+      partitioned.push(value);
+    }
+    return partitioned;
+  }(std::make_index_sequence<8>{});
+
+  const auto visited = [&] {
+    u64 sum{0};
+    for (const auto& value: values) {
+      sum += value.visit(weigh);
+    }
+    return sum;
+  };
+
+  const auto batched = [&] {
+    u64 sum{0};
+    partitioned.for_each([&](const auto& value) { sum += weigh(value); });
+    return sum;
+  };
+
+  REQUIRE(visited() == batched());
+
+  BENCHMARK("Vec<AnyOf>::visit") {
+    return visited();
+  };
+
+  BENCHMARK("VariantVec::for_each") {
+    return batched();
+  };
+}
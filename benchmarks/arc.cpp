@@ -0,0 +1,50 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <memory>
+#include <thread>
+#include <vector>
+#include <crab/preamble.hpp>
+
+namespace {
+  constexpr usize clones_per_thread{50'000};
+
+  /// Clones & drops the given shared pointer 'clones_per_thread' times on each of 'thread_count' threads.
+  template<typename Ptr>
+  auto contend(const Ptr& shared, const usize thread_count) -> usize {
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count);
+
+    for (usize i = 0; i < thread_count; i++) {
+      threads.emplace_back([&shared] {
+        for (usize j = 0; j < clones_per_thread; j++) {
+          const Ptr clone{shared};
+          crab::discard(clone);
+        }
+      });
+    }
+
+    for (std::thread& thread: threads) {
+      thread.join();
+    }
+
+    return thread_count;
+  }
+}
+
+TEST_CASE("Arc clone/drop contention", "[arc][benchmark]") {
+  const Arc<u64> arc{crab::make_arc<u64>(42u)};
+  const std::shared_ptr<const u64> shared{std::make_shared<u64>(42u)};
+
+  for (const usize thread_count: {1_usize, 2_usize, 4_usize, 8_usize}) {
+    BENCHMARK(fmt::format("Arc<T> ({} threads)", thread_count)) {
+      return contend(arc, thread_count);
+    };
+
+    BENCHMARK(fmt::format("std::shared_ptr<T> ({} threads)", thread_count)) {
+      return contend(shared, thread_count);
+    };
+  }
+
+  REQUIRE(arc.is_unique());
+}
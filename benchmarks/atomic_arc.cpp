@@ -0,0 +1,127 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <crab/preamble.hpp>
+
+namespace {
+  constexpr usize loads_per_thread{20'000};
+
+  /// Routing-table stand-in, big enough that copying it instead of sharing it would be noticeable.
+  struct Snapshot {
+    std::array<u64, 64> entries{};
+  };
+
+  /// AtomicArc<T> behind the common load / store interface used by 'read_mostly'
+  struct CrabCell {
+    AtomicArc<Snapshot> cell{crab::make_arc<Snapshot>()};
+
+    [[nodiscard]] auto load() const -> u64 {
+      return cell.load()->entries[0];
+    }
+
+    auto store() -> void {
+      cell.store(crab::make_arc<Snapshot>());
+    }
+  };
+
+  /// The simplest thing that works: an Arc guarded by a mutex
+  struct MutexCell {
+    mutable std::mutex mutex;
+    Arc<Snapshot> value{crab::make_arc<Snapshot>()};
+
+    [[nodiscard]] auto load() const -> u64 {
+      const Arc<Snapshot> copy{[this] {
+        const std::scoped_lock lock{mutex};
+        return value;
+      }()};
+      return copy->entries[0];
+    }
+
+    auto store() -> void {
+      Arc<Snapshot> next{crab::make_arc<Snapshot>()};
+      const std::scoped_lock lock{mutex};
+      value = std::move(next);
+    }
+  };
+
+  struct SharedPtrCell {
+    std::atomic<std::shared_ptr<const Snapshot>> value{std::make_shared<const Snapshot>()};
+
+    [[nodiscard]] auto load() const -> u64 {
+      return value.load()->entries[0];
+    }
+
+    auto store() -> void {
+      value.store(std::make_shared<const Snapshot>());
+    }
+  };
+
+  /// 'thread_count' readers each load 'loads_per_thread' times, while a writer replaces the value as fast as it can.
+  template<typename Cell>
+  auto read_mostly(Cell& cell, const usize thread_count) -> u64 {
+    std::atomic_bool reading{true};
+    std::atomic<u64> sum{0};
+
+    std::thread writer{[&cell, &reading] {
+      while (reading.load(std::memory_order_relaxed)) {
+        cell.store();
+        std::this_thread::yield();
+      }
+    }};
+
+    std::vector<std::thread> readers;
+    readers.reserve(thread_count);
+
+    for (usize i = 0; i < thread_count; i++) {
+      readers.emplace_back([&cell, &sum] {
+        u64 local{0};
+        for (usize j = 0; j < loads_per_thread; j++) {
+          local += cell.load();
+        }
+        sum.fetch_add(local, std::memory_order_relaxed);
+      });
+    }
+
+    for (std::thread& reader: readers) {
+      reader.join();
+    }
+
+    reading = false;
+    writer.join();
+
+    return sum;
+  }
+}
+
+TEST_CASE("AtomicArc reader scaling", "[arc][benchmark]") {
+  CrabCell crab_cell;
+  MutexCell mutex_cell;
+  SharedPtrCell shared_cell;
+
+  std::vector<usize> thread_counts{1, 2, 4, 8};
+  if (const usize cores{std::thread::hardware_concurrency()}; cores > 8) {
+    thread_counts.push_back(cores);
+  }
+
+  for (const usize thread_count: thread_counts) {
+    BENCHMARK(fmt::format("AtomicArc<T> ({} readers)", thread_count)) {
+      return read_mostly(crab_cell, thread_count);
+    };
+
+    BENCHMARK(fmt::format("Mutex + Arc<T> ({} readers)", thread_count)) {
+      return read_mostly(mutex_cell, thread_count);
+    };
+
+    BENCHMARK(fmt::format("std::atomic<std::shared_ptr<T>> ({} readers)", thread_count)) {
+      return read_mostly(shared_cell, thread_count);
+    };
+  }
+
+  REQUIRE(crab_cell.cell.load().get_ref_count() == 2);
+}
@@ -0,0 +1,73 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <thread>
+#include <vector>
+#include <crab/preamble.hpp>
+
+namespace {
+  constexpr usize clones_per_thread{50'000};
+
+  /// Clones & drops the given pointer 'clones_per_thread' times on the calling thread only.
+  template<typename Ptr>
+  auto owner_only(const Ptr& shared) -> usize {
+    usize sum{0};
+
+    for (usize j = 0; j < clones_per_thread; j++) {
+      const Ptr clone{shared};
+      sum += clone.get_ref_count();
+    }
+
+    return sum;
+  }
+
+  /// Clones & drops the given pointer 'clones_per_thread' times on each of 'thread_count' threads, as well as the owner.
+  template<typename Ptr>
+  auto shared_with(const Ptr& shared, const usize thread_count) -> usize {
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count);
+
+    for (usize i = 0; i < thread_count; i++) {
+      threads.emplace_back([&shared] {
+        for (usize j = 0; j < clones_per_thread; j++) {
+          const Ptr clone{shared};
+          crab::discard(clone);
+        }
+      });
+    }
+
+    const usize sum{owner_only(shared)};
+
+    for (std::thread& thread: threads) {
+      thread.join();
+    }
+
+    return sum;
+  }
+}
+
+TEST_CASE("BiasedArc clone/drop", "[arc][benchmark]") {
+  const Arc<u64> arc{crab::make_arc<u64>(42u)};
+  const BiasedArc<u64> biased{crab::make_biased_arc<u64>(42u)};
+
+  BENCHMARK("Arc<T> (owner only)") {
+    return owner_only(arc);
+  };
+
+  BENCHMARK("BiasedArc<T> (owner only)") {
+    return owner_only(biased);
+  };
+
+  for (const usize thread_count: {1_usize, 2_usize, 4_usize}) {
+    BENCHMARK(fmt::format("Arc<T> (owner + {} threads)", thread_count)) {
+      return shared_with(arc, thread_count);
+    };
+
+    BENCHMARK(fmt::format("BiasedArc<T> (owner + {} threads)", thread_count)) {
+      return shared_with(biased, thread_count);
+    };
+  }
+
+  REQUIRE(arc.is_unique());
+  REQUIRE(biased.is_unique());
+}
@@ -0,0 +1,58 @@
+/// Compile time benchmark, this is not run. Building the crab-compile-benchmark target instantiates hundreds of
+/// distinct AnyOf / Result types and has the compiler report how long it spent on them.
+
+#include <utility>
+#include <crab/preamble.hpp>
+
+namespace {
+  /// Number of distinct Result / AnyOf instantiations
+  constexpr usize instantiations{256};
+
+  /// Distinct alternative, J is the position in its AnyOf
+  template<usize I, usize J>
+  struct Alternative {
+    u64 value;
+  };
+
+  template<usize I>
+  struct Error {
+    u32 code;
+  };
+
+  template<usize I>
+  auto use_result(const u64 input) -> u64 {
+    using R = Result<Alternative<I, 0>, Error<I>>;
+
+    R result{input % 2 == 0 ? R{Alternative<I, 0>{input}} : R{Error<I>{static_cast<u32>(input)}}};
+
+    if (result.is_ok()) {
+      return crab::move(result)
+        .map([](const Alternative<I, 0> value) { return value.value + I; })
+        .unwrap();
+    }
+
+    return crab::move(result).unwrap_err().code;
+  }
+
+  template<usize I>
+  auto use_any_of(const u64 input) -> u64 {
+    return [&]<usize... Js>(std::index_sequence<Js...>) {
+      using Any = AnyOf<Alternative<I, Js>...>;
+
+      Any value{Alternative<I, 3>{input}};
+      value = Alternative<I, 5>{input + 1};
+
+      u64 sum{value.visit([]<usize J>(const Alternative<I, J>& alternative) { return alternative.value * J; })};
+      sum += value.template as<Alternative<I, 5>>().is_some() ? Any::template IndexOf<Alternative<I, 5>> : 0;
+      sum += value.template is<Alternative<I, 0>>() ? 1 : 0;
+
+      return sum;
+    }(std::make_index_sequence<8>{});
+  }
+}
+
+auto crab_compile_time_benchmark(const u64 input) -> u64 {
+  return []<usize... Is>(const u64 input, std::index_sequence<Is...>) {
+    return ((use_result<Is>(input) + use_any_of<Is>(input)) + ...);
+  }(input, std::make_index_sequence<instantiations>{});
+}
@@ -0,0 +1,96 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <vector>
+#include <crab/preamble.hpp>
+
+#include "alloc_counter.hpp"
+
+namespace {
+  constexpr usize requests{10'000};
+
+  struct FieldCategory final : crab::ErrorCategory {
+    [[nodiscard]] auto name() const -> StringView override {
+      return "field";
+    }
+
+    [[nodiscard]] auto message(const i32) const -> StringView override {
+      return "out of range";
+    }
+  };
+
+  constexpr FieldCategory field_category;
+
+  /// Field values, 30% of which are rejected
+  auto make_input() -> std::vector<u32> {
+    std::vector<u32> input;
+    input.reserve(requests);
+
+    for (usize i = 0; i < requests; i++) {
+      input.push_back(i % 10 < 3 ? 1'000 : static_cast<u32>(i % 100));
+    }
+
+    return input;
+  }
+
+  auto check_field(const u32 value) -> Result<u32, ErrorCode> {
+    if (value >= 100) {
+      return ErrorCode{field_category, 0};
+    }
+    return value;
+  }
+
+  /// Context added by building a message as the error is propagated
+  auto validate_with_string(const u32 value) -> Result<u32, String> {
+    Result<u32, ErrorCode> field{check_field(value)};
+    if (field.is_err()) {
+      return fmt::format("validating a request: checking a field: {}", field.get_err());
+    }
+    return crab::move(field).unwrap();
+  }
+
+  auto check_field_with_context(const u32 value) -> Result<u32, ContextError<ErrorCode>> {
+    return check_field(value).context("checking a field");
+  }
+
+  /// Context added as static frames, formatted only if the error is
+  auto validate_with_context(const u32 value) -> Result<u32, ContextError<ErrorCode>> {
+    return check_field_with_context(value).context("validating a request");
+  }
+
+  template<typename F>
+  auto accepted_total(const std::vector<u32>& input, F&& validate) -> u64 {
+    u64 total{0};
+    for (const u32 value: input) {
+      auto result{validate(value)};
+      if (result.is_ok()) {
+        total += crab::move(result).unwrap();
+      }
+    }
+    return total;
+  }
+}
+
+TEST_CASE("Error context", "[result][error][benchmark]") {
+  const std::vector<u32> input{make_input()};
+
+  REQUIRE(accepted_total(input, validate_with_string) == accepted_total(input, validate_with_context));
+  REQUIRE(fmt::format("{}", validate_with_context(1'000).get_err()) == validate_with_string(1'000).get_err());
+
+  WARN(
+    "String context allocations: "
+    << bench::count_allocations([&] { crab::discard(accepted_total(input, validate_with_string)); })
+  );
+  WARN(
+    "ContextError allocations: "
+    << bench::count_allocations([&] { crab::discard(accepted_total(input, validate_with_context)); })
+  );
+
+  BENCHMARK("String context") {
+    return accepted_total(input, validate_with_string);
+  };
+
+  BENCHMARK("ContextError") {
+    return accepted_total(input, validate_with_context);
+  };
+}
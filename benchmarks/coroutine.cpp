@@ -0,0 +1,163 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <utility>
+#include <vector>
+#include <crab/preamble.hpp>
+#include <crab/opt/coroutine.hpp>
+#include <crab/result/coroutine.hpp>
+
+#include "alloc_counter.hpp"
+
+namespace {
+  constexpr usize fields{10'000};
+
+  enum class ParseError : u8 { Empty, NotDigit };
+
+  /// Comma separated fields of digits, every 16th field is invalid
+  auto make_input() -> std::vector<String> {
+    std::vector<String> input;
+    input.reserve(fields);
+
+    for (usize i = 0; i < fields; i++) {
+      input.push_back(i % 16 == 15 ? String{"12x,4"} : fmt::format("{},{}", i, i * 7));
+    }
+
+    return input;
+  }
+
+  auto parse_digit(const char c) -> Result<u32, ParseError> {
+    if (c < '0' or c > '9') {
+      return ParseError::NotDigit;
+    }
+    return static_cast<u32>(c - '0');
+  }
+
+  /// Parses "a,b" into a + b, returning early by hand
+  auto sum_field(const StringView field) -> Result<u32, ParseError> {
+    if (field.empty()) {
+      return ParseError::Empty;
+    }
+
+    u32 sum{0};
+    u32 number{0};
+    for (const char c: field) {
+      if (c == ',') {
+        sum += std::exchange(number, 0);
+        continue;
+      }
+
+      Result<u32, ParseError> digit{parse_digit(c)};
+      if (digit.is_err()) {
+        return crab::move(digit).unwrap_err();
+      }
+      number = number * 10 + crab::move(digit).unwrap();
+    }
+
+    return sum + number;
+  }
+
+  /// Parses "a,b" into a + b, returning early with co_await
+  auto sum_field_coroutine(const StringView field) -> Result<u32, ParseError> {
+    if (field.empty()) {
+      co_return ParseError::Empty;
+    }
+
+    u32 sum{0};
+    u32 number{0};
+    for (const char c: field) {
+      if (c == ',') {
+        sum += std::exchange(number, 0);
+        continue;
+      }
+
+      number = number * 10 + co_await parse_digit(c);
+    }
+
+    co_return sum + number;
+  }
+
+  template<typename F>
+  auto sum_fields(const std::vector<String>& input, F&& sum_field) -> u64 {
+    u64 sum{0};
+    for (const String& field: input) {
+      Result<u32, ParseError> parsed{sum_field(field)};
+      if (parsed.is_ok()) {
+        sum += crab::move(parsed).unwrap();
+      }
+    }
+    return sum;
+  }
+
+  auto first_digit(const StringView field) -> Option<u32> {
+    if (field.empty() or field.front() < '0' or field.front() > '9') {
+      return crab::none;
+    }
+    return static_cast<u32>(field.front() - '0');
+  }
+
+  /// Sum of the first digits of two fields, returning early by hand
+  auto first_digits(const StringView a, const StringView b) -> Option<u32> {
+    Option<u32> first{first_digit(a)};
+    if (first.is_none()) {
+      return crab::none;
+    }
+
+    Option<u32> second{first_digit(b)};
+    if (second.is_none()) {
+      return crab::none;
+    }
+
+    return crab::move(first).unwrap() + crab::move(second).unwrap();
+  }
+
+  /// Sum of the first digits of two fields, returning early with co_await
+  auto first_digits_coroutine(const StringView a, const StringView b) -> Option<u32> {
+    const u32 first{co_await first_digit(a)};
+    const u32 second{co_await first_digit(b)};
+    co_return first + second;
+  }
+
+  template<typename F>
+  auto sum_first_digits(const std::vector<String>& input, F&& first_digits) -> u64 {
+    u64 sum{0};
+    for (usize i = 1; i < input.size(); i++) {
+      sum += first_digits(input[i - 1], input[i]).get_or(0);
+    }
+    return sum;
+  }
+}
+
+TEST_CASE("Result early return", "[result][coroutine][benchmark]") {
+  const std::vector<String> input{make_input()};
+
+  REQUIRE(sum_fields(input, sum_field) == sum_fields(input, sum_field_coroutine));
+
+  // frames that are not elided (GCC never elides them) come from the frame pool, which is warm by now
+  WARN(
+    "global allocations: "
+    << bench::count_allocations([&] { crab::discard(sum_fields(input, sum_field_coroutine)); })
+  );
+
+  BENCHMARK("is_err / unwrap_err") {
+    return sum_fields(input, sum_field);
+  };
+
+  BENCHMARK("co_await") {
+    return sum_fields(input, sum_field_coroutine);
+  };
+}
+
+TEST_CASE("Option early return", "[option][coroutine][benchmark]") {
+  const std::vector<String> input{make_input()};
+
+  REQUIRE(sum_first_digits(input, first_digits) == sum_first_digits(input, first_digits_coroutine));
+
+  BENCHMARK("is_none") {
+    return sum_first_digits(input, first_digits);
+  };
+
+  BENCHMARK("co_await") {
+    return sum_first_digits(input, first_digits_coroutine);
+  };
+}
@@ -0,0 +1,106 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <vector>
+#include <crab/preamble.hpp>
+
+namespace {
+  constexpr usize node_count{10'000};
+
+  /// Same hierarchy twice, once left to dynamic_cast and once type identified
+  struct Dynamic {
+    struct Node : crab::ref::TypeTag {
+      using TypeTag::TypeTag;
+      Node(const Node&) = delete;
+      Node(Node&&) = delete;
+      auto operator=(const Node&) -> Node& = delete;
+      auto operator=(Node&&) -> Node& = delete;
+      virtual ~Node() = default;
+    };
+
+    struct Literal final : Node {
+      explicit Literal(const u64 value): Node{1}, value{value} {}
+
+      u64 value;
+    };
+
+    struct Binary final : Node {
+      Binary(): Node{2} {}
+    };
+  };
+
+  struct Tagged {
+    struct Node : crab::ref::TypeTag {
+      static constexpr crab::ref::TypeRange<Node> crab_type_range{0, 2};
+
+      using TypeTag::TypeTag;
+      Node(const Node&) = delete;
+      Node(Node&&) = delete;
+      auto operator=(const Node&) -> Node& = delete;
+      auto operator=(Node&&) -> Node& = delete;
+      virtual ~Node() = default;
+    };
+
+    struct Literal final : Node {
+      static constexpr crab::ref::TypeRange<Literal> crab_type_range{1, 1};
+
+      explicit Literal(const u64 value): Node{crab_type_range.first}, value{value} {}
+
+      u64 value;
+    };
+
+    struct Binary final : Node {
+      static constexpr crab::ref::TypeRange<Binary> crab_type_range{2, 2};
+
+      Binary(): Node{crab_type_range.first} {}
+    };
+  };
+
+  template<typename H>
+  auto make_nodes() -> std::vector<Box<typename H::Node>> {
+    std::vector<Box<typename H::Node>> nodes;
+    nodes.reserve(node_count);
+
+    for (usize i = 0; i < node_count; i++) {
+      if (i % 3 == 0) {
+        nodes.emplace_back(crab::make_box<typename H::Binary>());
+      } else {
+        nodes.emplace_back(crab::make_box<typename H::Literal>(i));
+      }
+    }
+
+    return nodes;
+  }
+
+  /// Sums the value of every literal node
+  template<typename H>
+  auto sum_literals(const std::vector<Box<typename H::Node>>& nodes) -> u64 {
+    u64 sum{0};
+
+    for (const auto& node: nodes) {
+      if (auto literal = node.template downcast<typename H::Literal>()) {
+        sum += literal.get().value;
+      }
+    }
+
+    return sum;
+  }
+}
+
+TEST_CASE("Box downcast", "[box][benchmark]") {
+  STATIC_REQUIRE(not crab::ref::fast_castable<Dynamic::Literal, Dynamic::Node>);
+  STATIC_REQUIRE(crab::ref::fast_castable<Tagged::Literal, Tagged::Node>);
+
+  const auto dynamic{make_nodes<Dynamic>()};
+  const auto tagged{make_nodes<Tagged>()};
+
+  REQUIRE(sum_literals<Dynamic>(dynamic) == sum_literals<Tagged>(tagged));
+
+  BENCHMARK("dynamic_cast") {
+    return sum_literals<Dynamic>(dynamic);
+  };
+
+  BENCHMARK("TypeRange") {
+    return sum_literals<Tagged>(tagged);
+  };
+}
@@ -0,0 +1,109 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <vector>
+#include <crab/preamble.hpp>
+
+#include "alloc_counter.hpp"
+
+namespace {
+  constexpr usize requests{10'000};
+
+  enum class Rejection : i32 { TooLarge, Reserved };
+
+  /// Rejection as an IError, with its message put together when it is created
+  class RejectionError final : public crab::IError {
+  public:
+
+    RejectionError(const Rejection rejection, const u32 value):
+        message{fmt::format("{} ({})", rejection == Rejection::TooLarge ? "too large" : "reserved", value)} {}
+
+    [[nodiscard]] auto what() const -> String override {
+      return message;
+    }
+
+  private:
+
+    String message;
+  };
+
+  struct RejectionCategory final : crab::ErrorCategory {
+    [[nodiscard]] auto name() const -> StringView override {
+      return "validation";
+    }
+
+    [[nodiscard]] auto message(const i32 value) const -> StringView override {
+      return static_cast<Rejection>(value) == Rejection::TooLarge ? "too large" : "reserved";
+    }
+  };
+
+  constexpr RejectionCategory rejection_category;
+
+  /// Request sizes, 30% of which are rejected
+  auto make_input() -> std::vector<u32> {
+    std::vector<u32> input;
+    input.reserve(requests);
+
+    for (usize i = 0; i < requests; i++) {
+      switch (i % 10) {
+        case 0:
+        case 3:  input.push_back(100'000 + static_cast<u32>(i)); break;
+        case 7:  input.push_back(0); break;
+        default: input.push_back(static_cast<u32>(i)); break;
+      }
+    }
+
+    return input;
+  }
+
+  auto validate(const u32 size) -> Result<u32, RejectionError> {
+    if (size > 65'536) {
+      return RejectionError{Rejection::TooLarge, size};
+    }
+    if (size == 0) {
+      return RejectionError{Rejection::Reserved, size};
+    }
+    return size;
+  }
+
+  auto validate_code(const u32 size) -> Result<u32, ErrorCode> {
+    if (size > 65'536) {
+      return ErrorCode{rejection_category, Rejection::TooLarge, "validating request size"};
+    }
+    if (size == 0) {
+      return ErrorCode{rejection_category, Rejection::Reserved, "validating request size"};
+    }
+    return size;
+  }
+
+  template<typename F>
+  auto accepted_total(const std::vector<u32>& input, F&& validate) -> u64 {
+    u64 total{0};
+    for (const u32 size: input) {
+      auto result{validate(size)};
+      if (result.is_ok()) {
+        total += crab::move(result).unwrap();
+      }
+    }
+    return total;
+  }
+}
+
+TEST_CASE("Error values", "[result][error][benchmark]") {
+  const std::vector<u32> input{make_input()};
+
+  REQUIRE(accepted_total(input, validate) == accepted_total(input, validate_code));
+
+  WARN("IError allocations: " << bench::count_allocations([&] { crab::discard(accepted_total(input, validate)); }));
+  WARN(
+    "ErrorCode allocations: " << bench::count_allocations([&] { crab::discard(accepted_total(input, validate_code)); })
+  );
+
+  BENCHMARK("IError") {
+    return accepted_total(input, validate);
+  };
+
+  BENCHMARK("ErrorCode") {
+    return accepted_total(input, validate_code);
+  };
+}
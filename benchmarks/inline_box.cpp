@@ -0,0 +1,85 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <crab/preamble.hpp>
+
+#include "alloc_counter.hpp"
+
+namespace {
+  constexpr usize messages{10'000};
+
+  struct Handler {
+    Handler() = default;
+    Handler(const Handler&) = default;
+    Handler(Handler&&) noexcept = default;
+    auto operator=(const Handler&) -> Handler& = default;
+    auto operator=(Handler&&) noexcept -> Handler& = default;
+    virtual ~Handler() = default;
+
+    [[nodiscard]] virtual auto handle(u64 message) const -> u64 = 0;
+  };
+
+  struct Scale final : Handler {
+    explicit Scale(const u64 factor): factor{factor} {}
+
+    [[nodiscard]] auto handle(const u64 message) const -> u64 override {
+      return message * factor;
+    }
+
+    u64 factor;
+  };
+
+  struct Offset final : Handler {
+    explicit Offset(const u64 offset): offset{offset} {}
+
+    [[nodiscard]] auto handle(const u64 message) const -> u64 override {
+      return message + offset;
+    }
+
+    u64 offset;
+  };
+
+  /// Creates, dispatches to & destroys a handler for every message
+  template<typename Make>
+  auto per_message(Make&& make) -> u64 {
+    u64 sum{0};
+
+    for (u64 i = 0; i < messages; i++) {
+      const auto handler{make(i)};
+      sum += handler->handle(i);
+    }
+
+    return sum;
+  }
+
+  using InlineHandler = InlineBox<Handler, 16>;
+}
+
+TEST_CASE("InlineBox create/dispatch/destroy", "[box][benchmark]") {
+  const auto boxed = [](const u64 i) -> Box<Handler> {
+    if (i % 2 == 0) {
+      return crab::make_box<Scale>(i);
+    }
+    return crab::make_box<Offset>(i);
+  };
+
+  const auto inlined = [](const u64 i) -> InlineHandler {
+    if (i % 2 == 0) {
+      return crab::make_inline_box<Handler, 16, Scale>(i);
+    }
+    return crab::make_inline_box<Handler, 16, Offset>(i);
+  };
+
+  REQUIRE(per_message(boxed) == per_message(inlined));
+
+  CHECK(bench::count_allocations([&] { crab::discard(per_message(boxed)); }) == messages);
+  CHECK(bench::count_allocations([&] { crab::discard(per_message(inlined)); }) == 0);
+
+  BENCHMARK("Box<T>") {
+    return per_message(boxed);
+  };
+
+  BENCHMARK("InlineBox<T, 16>") {
+    return per_message(inlined);
+  };
+}
@@ -0,0 +1,67 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <memory>
+#include <crab/preamble.hpp>
+
+#include "alloc_counter.hpp"
+
+namespace {
+  struct Payload {
+    Payload(const u64 id, const u64 parent, const f64 weight): id{id}, parent{parent}, weight{weight} {}
+
+    u64 id;
+    u64 parent;
+    f64 weight;
+  };
+
+  /// Rc with the pre-fused layout, where the value and the control block are two separate allocations.
+  auto make_split_rc(const u64 id) -> Rc<Payload> {
+    return Rc<Payload>::from_owned_unchecked(new Payload{id, 0, 1.0});
+  }
+}
+
+TEST_CASE("Rc allocation layout", "[rc][benchmark]") {
+  SECTION("allocation count") {
+    CHECK(bench::count_allocations([] { crab::discard(crab::make_rc<Payload>(1u, 0u, 1.0)); }) == 1);
+    CHECK(bench::count_allocations([] { crab::discard(crab::make_rc_mut<Payload>(1u, 0u, 1.0)); }) == 1);
+
+    // the first split control block comes from the global allocator, after that it is reused from the counter pool
+    crab::discard(make_split_rc(0));
+    CHECK(bench::count_allocations([] { crab::discard(make_split_rc(1)); }) == 1);
+    CHECK(bench::count_allocations([] { crab::discard(Rc<Payload>{crab::make_box<Payload>(1u, 0u, 1.0)}); }) == 1);
+    CHECK(bench::count_allocations([] { crab::discard(Arc<Payload>{crab::make_box<Payload>(1u, 0u, 1.0)}); }) == 2);
+  }
+
+  constexpr usize batch{1024};
+
+  BENCHMARK("make_rc (fused)") {
+    u64 sum{0};
+    for (u64 i = 0; i < batch; i++) {
+      const Rc<Payload> rc{crab::make_rc<Payload>(i, 0u, 1.0)};
+      const Rc<Payload> clone{rc.clone()};
+      sum += clone->id;
+    }
+    return sum;
+  };
+
+  BENCHMARK("from_owned_unchecked (split)") {
+    u64 sum{0};
+    for (u64 i = 0; i < batch; i++) {
+      const Rc<Payload> rc{make_split_rc(i)};
+      const Rc<Payload> clone{rc.clone()};
+      sum += clone->id;
+    }
+    return sum;
+  };
+
+  BENCHMARK("std::make_shared") {
+    u64 sum{0};
+    for (u64 i = 0; i < batch; i++) {
+      const std::shared_ptr<const Payload> ptr{std::make_shared<Payload>(i, 0u, 1.0)};
+      const std::shared_ptr<const Payload> clone{ptr};
+      sum += clone->id;
+    }
+    return sum;
+  };
+}
@@ -3,7 +3,7 @@
 
 #pragma once
 
-#include <iterator>
+#include <cstddef>
 #include <type_traits>
 #include "crab/core/unreachable.hpp"
 #include "crab/core/unsafe.hpp"
@@ -18,9 +18,12 @@
 
 #include "crab/any/impl/AnyOfStorage.hpp"
 #include "crab/any/impl/Buffer.hpp"
+#include "crab/any/impl/dispatch.hpp"
 #include "crab/any/impl/visitor.hpp"
 #include "crab/ty/identity.hpp"
+#include "crab/ty/pack.hpp"
 #include "crab/opt/Option.hpp"
+#include "crab/opt/niche.hpp"
 
 namespace crab::any {
 
@@ -31,6 +34,8 @@ namespace crab::any {
   /// is only safe to destroy or reassign.
   ///
   /// The use case of AnyOf is to be able to store a value that could be *one of* a set of finite types.
+  /// An AnyOf is as large as its largest alternative, if one of them is much larger than the rest consider
+  /// CompactAnyOf, which stores large alternatives out of line.
   ///
   /// # Example
   ///
@@ -55,14 +60,11 @@ namespace crab::any {
   /// @ingroup any
   /// @ingroup prelude
   template<typename... Ts>
-  class AnyOf final : private impl::AnyOfConstructor<Ts>... {
+  class AnyOf final {
     /// AnyOf would be significantly more complex to support non-moveable types, a case that is not worth it in my
     /// opinion.
     /// I would much rather value the invariant "all instantiations of AnyOf<Ts...> are moveable".
-    static_assert(
-      ((ty::movable<Ts> or ty::is_reference<Ts>) and ...),
-      "Cannot construct an AnyOf with an immovable Type"
-    );
+    static_assert(impl::all_movable<Ts...>, "Cannot construct an AnyOf with an immovable Type");
 
     /// const-ness of AnyOf is transitive, note this does not apply to references.
     static_assert((ty::non_const<Ts> and ...), "Cannot have a variant of AnyOf be const");
@@ -74,15 +76,7 @@ namespace crab::any {
       "Cannot have an AnyOf<Ts...> instantiate that recursively contains itself."
     );
 
-    /// Constexpr helper for counting the occurences of T to check for multiple occurences in the same AnyOf
-    /// (which is not allowed).
-    /// @internal
-    template<typename T>
-    static constexpr auto instances_of_type() -> usize {
-      return ([]() { return ty::same_as<T, Ts> ? 1 : 0; }() + ...);
-    }
-
-    static_assert(((instances_of_type<Ts>() == 1) and ...), "Cannot have duplicate types in an AnyOf");
+    static_assert(ty::unique_types<Ts...>, "Cannot have duplicate types in an AnyOf");
 
   public:
 
@@ -108,17 +102,6 @@ namespace crab::any {
     template<ty::either<Ts...> T>
     using Storage = impl::AnyOfStorage<T>;
 
-    /// Helper for implementation of AnyOf::IndexOf
-    /// @internal
-    template<typename T>
-    static CRAB_CONSTEVAL auto find_index_of_type() -> usize {
-      const std::array<bool, NumTypes> state{
-        ty::same_as<T, Ts>...,
-      };
-
-      return std::distance(state.begin(), std::ranges::find(state, true));
-    }
-
   public:
 
     /// self explanatory
@@ -162,7 +145,7 @@ namespace crab::any {
     /// ```
     /// @hideinitializer
     template<ty::either<Ts...> T>
-    static constexpr usize IndexOf = find_index_of_type<T>();
+    static constexpr usize IndexOf = ty::index_of<T, Ts...>;
 
   private:
 
@@ -174,17 +157,10 @@ namespace crab::any {
       Storage<NthType<I>>::construct(buffer, mem::forward<NthType<I>>(value));
     }
 
-    /// Inherited helper for easier selection of value construction for a specific type
-    /// @internal
-    using impl::AnyOfConstructor<Ts>::impl_construct...;
-
-    /// Inherited helper for easier selection of value construction for a specific type
-    /// @internal
-    using impl::AnyOfConstructor<Ts>::impl_insert...;
-
-    /// Inherited helper for easier selection of value construction for a specific type
+    /// Index of the alternative that a value of type T is converted to
     /// @internal
-    using impl::AnyOfConstructor<Ts>::impl_emplace...;
+    template<typename T>
+    static constexpr usize ConvertedIndex{impl::converted_index<T, Ts...>};
 
   public:
 
@@ -225,57 +201,54 @@ namespace crab::any {
     /// AnyOf<u32& ,const u32&> v = a;
     /// ```
     template<typename T>
-    constexpr AnyOf(T&& value) /* NOLINT, silence warnings about hiding forward constructors */ {
+    constexpr AnyOf(T&& value) /* NOLINT, silence warnings about hiding forward constructors */
+        : index{ConvertedIndex<T>} {
 
       /// SFINAE guard to prevent this constructor from hiding AnyOf's move constructor
       static_assert(ty::different_than<T, AnyOf>);
-      const auto result{
-        impl_construct(mem::forward<T>(value), buffer),
-      };
-      index = IndexOf<typename decltype(result)::type>;
+
+      Storage<NthType<ConvertedIndex<T>>>::construct(buffer, mem::forward<T>(value));
     }
 
+    /// Move constructor, this is trivial if it is for every alternative (in which case the moved-from AnyOf is left as
+    /// it was, rather than invalidated).
+    constexpr AnyOf(AnyOf&&) noexcept requires impl::trivially_move_constructible<Ts...>
+    = default;
+
     /// Move constructor
     constexpr AnyOf(AnyOf&& from) noexcept((std::is_nothrow_move_constructible_v<Ts> and ...)): index{from.index} {
       crab_check(from.is_valid(), "Cannot construct AnyOf from an invalid (moved-from) AnyOf");
 
-      ([this, &from]() {
-        if (index != IndexOf<Ts>) {
-          return false;
-        }
-
-        Storage<Ts>::move(from.buffer, buffer);
-        return true;
-      }()
-       or ...);
+      impl::dispatch<NumTypes, void>(index, [this, &from]<usize I>() {
+        Storage<NthType<I>>::move(from.buffer, buffer);
+      });
 
       from.destroy();
       from.invalidate();
     }
 
+    /// Copy constructor, this is trivial if it is for every alternative.
+    constexpr AnyOf(const AnyOf&) requires impl::trivially_copy_constructible<Ts...>
+    = default;
+
     /// Copy constructor, only valid if all instances of AnyOf are valid.
-    constexpr AnyOf(const AnyOf& from) requires(ty::copyable<Ts> and ...)
+    constexpr AnyOf(const AnyOf& from) requires impl::nontrivially_copy_constructible<Ts...>
         : index{from.index} {
 
       /// for optimisations with certain API's, this function allows construction from moved-from AnyOf's.
       // crab_check(from.is_valid(), "Cannot construct AnyOf from an invalid (moved-from) AnyOf");
 
-      static_assert(
-        (ty::copyable<Ts> and ...),
-        "Cannot copy construct an AnyOf<Ts...> that may contain a non copyable type."
-      );
-
-      ([this, &from]() {
-        if (index != IndexOf<Ts>) {
-          return false;
-        }
-
-        Storage<Ts>::copy(from.buffer, buffer);
-        return true;
-      }()
-       or ...);
+      if (is_valid()) {
+        impl::dispatch<NumTypes, void>(index, [this, &from]<usize I>() {
+          Storage<NthType<I>>::copy(from.buffer, buffer);
+        });
+      }
     }
 
+    /// Destructor, this is trivial if it is for every alternative.
+    constexpr ~AnyOf() requires impl::trivially_destructible<Ts...>
+    = default;
+
     /// Destructor
     ~AnyOf() {
       if (not is_valid()) {
@@ -285,57 +258,53 @@ namespace crab::any {
       destroy();
     }
 
+    /// Copy assignment, this is trivial if it is for every alternative.
+    constexpr auto operator=(const AnyOf&) -> AnyOf& requires impl::trivially_copy_assignable<Ts...>
+    = default;
+
     /// Copy assignment, only valid of all variants Ts... are copyable.
-    auto operator=(const AnyOf& from) -> AnyOf& requires(ty::copyable<Ts>and...) {
+    auto operator=(const AnyOf& from) -> AnyOf& requires impl::nontrivially_copy_assignable<Ts...>
+    {
       if (mem::address_of(from) == this) [[unlikely]] {
         return *this;
       }
 
-      if (from.index == index) {
-        ([this, &from]() {
-          if (index != IndexOf<Ts>) {
-            return false;
-          }
-
-          Storage<Ts>::copy_asign(from.buffer, buffer);
-          return true;
-        }()
-         or ...);
+      if (from.index == index and is_valid()) {
+        impl::dispatch<NumTypes, void>(index, [this, &from]<usize I>() {
+          Storage<NthType<I>>::copy_assign(from.buffer, buffer);
+        });
         return *this;
       }
 
-      destroy();
-      index = from.index;
+      if (is_valid()) {
+        destroy();
+      }
 
-      ([this, &from]() {
-        if (index != IndexOf<Ts>) {
-          return false;
-        }
+      index = from.index;
 
-        Storage<Ts>::copy(from.buffer, buffer);
-        return true;
-      }()
-       or ...);
+      if (is_valid()) {
+        impl::dispatch<NumTypes, void>(index, [this, &from]<usize I>() {
+          Storage<NthType<I>>::copy(from.buffer, buffer);
+        });
+      }
 
       return *this;
     }
 
+    /// Move assignment, this is trivial if it is for every alternative.
+    constexpr auto operator=(AnyOf&&) noexcept -> AnyOf& requires impl::trivially_move_assignable<Ts...>
+    = default;
+
     /// Move assignment
     auto operator=(AnyOf&& from) noexcept -> AnyOf& {
       if (mem::address_of(from) == this) [[unlikely]] {
         return *this;
       }
 
-      if (from.index == index) {
-        ([this, &from]() {
-          if (index != IndexOf<Ts>) {
-            return false;
-          }
-
-          Storage<Ts>::move_assign(from.buffer, buffer);
-          return true;
-        }()
-         or ...);
+      if (from.index == index and is_valid()) {
+        impl::dispatch<NumTypes, void>(index, [this, &from]<usize I>() {
+          Storage<NthType<I>>::move_assign(from.buffer, buffer);
+        });
 
         from.destroy();
         from.invalidate();
@@ -343,21 +312,20 @@ namespace crab::any {
         return *this;
       }
 
-      destroy();
-      index = from.index;
+      if (is_valid()) {
+        destroy();
+      }
 
-      ([this, &from]() {
-        if (index != IndexOf<Ts>) {
-          return false;
-        }
+      index = from.index;
 
-        Storage<Ts>::move(from.buffer, buffer);
-        return true;
-      }()
-       or ...);
+      if (is_valid()) {
+        impl::dispatch<NumTypes, void>(index, [this, &from]<usize I>() {
+          Storage<NthType<I>>::move(from.buffer, buffer);
+        });
 
-      from.destroy();
-      from.invalidate();
+        from.destroy();
+        from.invalidate();
+      }
 
       return *this;
     }
@@ -383,11 +351,8 @@ namespace crab::any {
         destroy();
       }
 
-      auto result{
-        this->impl_insert(mem::forward<T>(value), buffer),
-      };
-
-      index = IndexOf<typename decltype(result)::type>;
+      Storage<NthType<ConvertedIndex<T>>>::construct(buffer, mem::forward<T>(value));
+      index = ConvertedIndex<T>;
     }
 
     template<typename T>
@@ -406,7 +371,7 @@ namespace crab::any {
         destroy();
       }
 
-      this->impl_emplace(std::type_identity<T>{}, buffer, mem::forward<Args>(args)...);
+      Storage<T>::construct(buffer, mem::forward<Args>(args)...);
       index = IndexOf<T>;
     }
 
@@ -464,25 +429,9 @@ namespace crab::any {
         "Visitor must be able to accept all types that could be contained in an AnyOf<Ts...>"
       );
 
-      using JumpTableFn = R (*)(const AnyOf& self, Visitor);
-
-      const std::array<JumpTableFn, NumTypes> table{
-        [](const AnyOf& self, Visitor visitor) -> R {
-          const Ts& value{self.as_unchecked<Ts>(unsafe)};
-
-          if constexpr (ty::not_void<R>) {
-            return std::invoke(visitor, value);
-          } else {
-            std::invoke(visitor, value);
-          }
-        }...,
-      };
-
-      if constexpr (ty::not_void<R>) {
-        return table.at(get_index())(*this, mem::forward<Visitor>(visitor));
-      } else {
-        table.at(get_index())(*this, mem::forward<Visitor>(visitor));
-      }
+      return impl::dispatch<NumTypes, R>(get_index(), [this, &visitor]<usize I>() -> R {
+        return std::invoke(mem::forward<Visitor>(visitor), as_unchecked<NthType<I>>(unsafe));
+      });
     }
 
     template<impl::VisitorForTypes<Ts&...> Visitor, typename R = impl::VisitorResultType<Visitor, Ts&...>>
@@ -495,25 +444,9 @@ namespace crab::any {
         "Visitor must be able to accept all types that could be contained in an AnyOf<Ts...>"
       );
 
-      using JumpTableFn = R (*)(AnyOf& self, Visitor);
-
-      const std::array<JumpTableFn, NumTypes> table{
-        [](AnyOf& self, Visitor visitor) -> R {
-          Ts& value{self.as_unchecked<Ts>(unsafe)};
-
-          if constexpr (ty::not_void<R>) {
-            return std::invoke(visitor, value);
-          } else {
-            std::invoke(visitor, value);
-          }
-        }...,
-      };
-
-      if constexpr (ty::not_void<R>) {
-        return table.at(get_index())(*this, mem::forward<Visitor>(visitor));
-      } else {
-        table.at(get_index())(*this, mem::forward<Visitor>(visitor));
-      }
+      return impl::dispatch<NumTypes, R>(get_index(), [this, &visitor]<usize I>() -> R {
+        return std::invoke(mem::forward<Visitor>(visitor), as_unchecked<NthType<I>>(unsafe));
+      });
     }
 
     /// R-value qualified version of visit. This overload is that performing this will leave the AnyOf invalid, as this
@@ -528,27 +461,9 @@ namespace crab::any {
         "Visitor must be able to accept all types that could be contained in an AnyOf<Ts...>"
       );
 
-      // using JumpTableFn = Func<R(const impl::Buffer<Size, Alignment>&, Visitor)>;
-
-      using JumpTableFn = R (*)(AnyOf self, Visitor);
-
-      const std::array<JumpTableFn, NumTypes> table{
-        [](AnyOf self, Visitor visitor) -> R {
-          Ts& value{mem::move(self).template as_unchecked<Ts>(unsafe)};
-
-          if constexpr (ty::not_void<R>) {
-            return std::invoke(visitor, value);
-          } else {
-            std::invoke(visitor, value);
-          }
-        }...,
-      };
-
-      if constexpr (ty::not_void<R>) {
-        return table.at(get_index())(mem::move(*this), mem::forward<Visitor>(visitor));
-      } else {
-        table.at(get_index())(mem::move(*this), mem::forward<Visitor>(visitor));
-      }
+      return impl::dispatch<NumTypes, R>(get_index(), [this, &visitor]<usize I>() -> R {
+        return std::invoke(mem::forward<Visitor>(visitor), mem::move(*this).template as_unchecked<NthType<I>>(unsafe));
+      });
     }
 
     /// }@
@@ -753,16 +668,10 @@ namespace crab::any {
 
   private:
 
-    /// Destroys interior
+    /// Destroys interior, this must only be called while valid
     /// @interior
     constexpr auto destroy() {
-      crab::discard(([this]() -> bool {
-        if (index == IndexOf<Ts>) {
-          Storage<Ts>::destroy(buffer);
-          return true;
-        }
-        return false;
-      }() or ...));
+      impl::dispatch<NumTypes, void>(index, [this]<usize I>() { Storage<NthType<I>>::destroy(buffer); });
     }
 
     /// Marks this instance as invalid
@@ -771,6 +680,18 @@ namespace crab::any {
       index = static_cast<u8>(-1);
     }
 
+    /// Index used by Option<AnyOf<Ts...>> to represent None, this is never a valid index nor the moved-from index.
+    /// @internal
+    static constexpr u8 NicheIndex{static_cast<u8>(-2)};
+
+    friend struct opt::Niche<AnyOf>;
+
+    /// Byte offset of the index, for the niche of Option<AnyOf<Ts...>>
+    /// @internal
+    [[nodiscard]] static CRAB_CONSTEVAL auto index_offset() -> usize {
+      return offsetof(AnyOf, index);
+    }
+
     /// Interior buffer to store the possible states
     /// @interior
     impl::Buffer<DataSize, Alignment> buffer;
@@ -781,6 +702,15 @@ namespace crab::any {
   };
 }
 
+namespace crab::opt {
+  /// Niche for AnyOf, using an index value that is out of range for its types
+  /// @ingroup opt
+  template<typename... Ts>
+  requires(sizeof...(Ts) < static_cast<u8>(-2))
+  struct Niche<any::AnyOf<Ts...>> :
+      BitNiche<any::AnyOf<Ts...>, u8, any::AnyOf<Ts...>::NicheIndex, any::AnyOf<Ts...>::index_offset()> {};
+}
+
 namespace crab::prelude {
   using any::AnyOf;
 }
@@ -0,0 +1,371 @@
+/// @file crab/any/CompactAnyOf.hpp
+/// @ingroup any
+
+#pragma once
+
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include "crab/core.hpp"
+#include "crab/core/cases.hpp"
+#include "crab/core/discard.hpp"
+#include "crab/core/unsafe.hpp"
+#include "crab/mem/forward.hpp"
+#include "crab/mem/move.hpp"
+#include "crab/num/integer.hpp"
+#include "crab/ty/classify.hpp"
+#include "crab/ty/compare.hpp"
+#include "crab/ty/identity.hpp"
+#include "crab/opt/Option.hpp"
+#include "crab/opt/niche.hpp"
+
+#include "crab/any/AnyOf.hpp"
+#include "crab/any/impl/AnyOfStorage.hpp"
+#include "crab/any/impl/Spilled.hpp"
+#include "crab/any/impl/visitor.hpp"
+
+namespace crab::any {
+
+  /// A sum type with the same interface as AnyOf<Ts...>, but whose inline storage is capped to Capacity bytes. Any
+  /// alternative larger than that is transparently stored in a Box instead.
+  ///
+  /// An AnyOf is as large as its largest alternative, so a single rarely used 512 byte alternative makes every value
+  /// of it 512 bytes. With CompactAnyOf that alternative costs a heap allocation when it is used, and every value is
+  /// only Capacity bytes (plus the index).
+  ///
+  /// Spilled alternatives are still accessed directly as T (through as<T>, match & visit), and a CompactAnyOf is
+  /// copyable if all of Ts are.
+  ///
+  /// # Examples
+  /// ```cpp
+  /// struct Ping { u32 id; };
+  /// struct Snapshot { std::array<std::byte, 512> data; };
+  ///
+  /// // 520 bytes
+  /// using Event = AnyOf<Ping, Snapshot>;
+  ///
+  /// // 16 bytes, Snapshot is held in a Box
+  /// using CompactEvent = CompactAnyOf<8, Ping, Snapshot>;
+  ///
+  /// CompactEvent event{Snapshot{}};
+  ///
+  /// event.match(
+  ///   [](const Ping& ping) { fmt::println("ping {}", ping.id); },
+  ///   [](const Snapshot& snapshot) { fmt::println("snapshot of {} bytes", snapshot.data.size()); }
+  /// );
+  /// ```
+  ///
+  /// @ingroup any
+  template<usize Capacity, typename... Ts>
+  class CompactAnyOf final {
+    static_assert(Capacity >= sizeof(void*), "A CompactAnyOf must have room for at least a pointer");
+
+    /// How T is stored in the inner AnyOf
+    /// @internal
+    template<typename T>
+    using Stored = impl::CompactStored<Capacity, T>;
+
+  public:
+
+    /// The AnyOf that values are actually stored in, where every alternative larger than Capacity is Spilled into a
+    /// Box.
+    using Inner = AnyOf<Stored<Ts>...>;
+
+    /// The total number of different types
+    static constexpr usize NumTypes{sizeof...(Ts)};
+
+    /// Whether T is stored out of line
+    template<ty::either<Ts...> T>
+    static constexpr bool IsSpilled{impl::spills<Capacity, T>};
+
+    /// The size of the inline storage buffer, this is at most Capacity.
+    static constexpr usize DataSize{Inner::DataSize};
+
+    /// The alignment of the inline storage buffer
+    static constexpr usize Alignment{Inner::Alignment};
+
+    /// Utility for indexing the 'Ts...' pack to get the nth type in the list, see AnyOf::NthType
+    template<usize I>
+    using NthType = ty::nth_type<I, Ts...>;
+
+    /// Utility for locating the index of a given type in the Ts pack, see AnyOf::IndexOf
+    template<ty::either<Ts...> T>
+    static constexpr usize IndexOf{Inner::template IndexOf<Stored<T>>};
+
+  private:
+
+    /// The alternative that a value of type T is converted to, this is the same choice AnyOf would make.
+    /// @internal
+    template<typename T>
+    using Selected = NthType<impl::converted_index<T, Ts...>>;
+
+    /// Stores the given value as T
+    /// @internal
+    template<ty::either<Ts...> T, typename... Args>
+    [[nodiscard]] static constexpr auto make_stored(Args&&... args) -> Stored<T> {
+      if constexpr (IsSpilled<T>) {
+        return Stored<T>{std::in_place, mem::forward<Args>(args)...};
+      } else if constexpr (ty::is_reference<T>) {
+        static_assert(sizeof...(Args) == 1, "A reference alternative can only be made from a single value");
+        return (mem::forward<Args>(args), ...);
+      } else {
+        return Stored<T>(mem::forward<Args>(args)...);
+      }
+    }
+
+    constexpr explicit CompactAnyOf(Inner inner): inner{mem::move(inner)} {}
+
+  public:
+
+    /// Factory method with explicit specification of the variant to emplace, see AnyOf::from
+    template<ty::either<Ts...> T>
+    [[nodiscard]] static constexpr auto from(ty::identity<T> value) -> CompactAnyOf {
+      return CompactAnyOf{Inner::template from<Stored<T>>(make_stored<T>(mem::forward<T>(value)))};
+    }
+
+    /// Factory method with explicit specification of the variant by index, see AnyOf::from
+    template<usize N>
+    [[nodiscard]] static constexpr auto from(NthType<N> value) -> CompactAnyOf {
+      static_assert(N < NumTypes, "Invalid type index passed to CompactAnyOf::from<usize>");
+
+      return from<NthType<N>>(mem::forward<NthType<N>>(value));
+    }
+
+    /// Construct a CompactAnyOf with the given value inside, which is converted to the same alternative that an AnyOf
+    /// would pick.
+    template<typename T>
+    requires ty::different_than<std::remove_cvref_t<T>, CompactAnyOf>
+    constexpr CompactAnyOf(T&& value) /* NOLINT, implicit like AnyOf's */:
+        inner{Inner::template from<Stored<Selected<T>>>(make_stored<Selected<T>>(mem::forward<T>(value)))} {}
+
+    /// @name Assignment
+    /// @{
+
+    /// Insert an existing value to replace the one stored, see AnyOf::insert
+    template<typename T>
+    constexpr auto insert(T&& value) & -> void {
+      emplace<Selected<T>>(mem::forward<T>(value));
+    }
+
+    template<typename T>
+    requires ty::different_than<std::remove_cvref_t<T>, CompactAnyOf>
+    constexpr auto operator=(T&& value) -> CompactAnyOf& {
+      insert<T>(mem::forward<T>(value));
+      return *this;
+    }
+
+    /// Construct a value of the specified type to replace the one stored, see AnyOf::emplace
+    template<ty::either<Ts...> T, typename... Args>
+    constexpr auto emplace(Args&&... args) & -> void {
+      if constexpr (IsSpilled<T>) {
+        inner.template emplace<Stored<T>>(std::in_place, mem::forward<Args>(args)...);
+      } else {
+        inner.template emplace<Stored<T>>(mem::forward<Args>(args)...);
+      }
+    }
+
+    /// @}
+
+    /// @name Visitor Methods
+    /// @{
+
+    template<typename... Fs, typename R = impl::VisitorResultType<crab::cases<Fs...>, const Ts&...>>
+    [[nodiscard]] constexpr auto match(Fs&&... functions) const& -> R {
+      static_assert(sizeof...(Fs) != 0, "Must have at least one functor to match with");
+
+      return visit<crab::cases<Fs...>, R>(crab::cases<Fs...>{mem::forward<Fs>(functions)...});
+    }
+
+    template<typename... Fs, typename R = impl::VisitorResultType<crab::cases<Fs...>, Ts&...>>
+    [[nodiscard]] constexpr auto match(Fs&&... functions) & -> R {
+      static_assert(sizeof...(Fs) != 0, "Must have at least one functor to match with");
+
+      return visit<crab::cases<Fs...>, R>(crab::cases<Fs...>{mem::forward<Fs>(functions)...});
+    }
+
+    template<typename... Fs, typename R = impl::VisitorResultType<crab::cases<Fs...>, Ts&&...>>
+    [[nodiscard]] constexpr auto match(Fs&&... functions) && -> R {
+      static_assert(sizeof...(Fs) != 0, "Must have at least one functor to match with");
+
+      return mem::move(*this).template visit<crab::cases<Fs...>, R>(crab::cases<Fs...>{mem::forward<Fs>(functions)...}
+      );
+    }
+
+    template<impl::VisitorForTypes<const Ts&...> Visitor, typename R = impl::VisitorResultType<Visitor, const Ts&...>>
+    [[nodiscard]] constexpr CRAB_INLINE auto visit(Visitor&& visitor) const& -> R {
+      return inner.visit([&visitor]<typename S>(S&& stored) -> R {
+        return std::invoke(mem::forward<Visitor>(visitor), impl::unspill(mem::forward<S>(stored)));
+      });
+    }
+
+    template<impl::VisitorForTypes<Ts&...> Visitor, typename R = impl::VisitorResultType<Visitor, Ts&...>>
+    [[nodiscard]] constexpr CRAB_INLINE auto visit(Visitor&& visitor) & -> R {
+      return inner.visit([&visitor]<typename S>(S&& stored) -> R {
+        return std::invoke(mem::forward<Visitor>(visitor), impl::unspill(mem::forward<S>(stored)));
+      });
+    }
+
+    /// R-value qualified version of visit, this leaves the CompactAnyOf invalid.
+    template<impl::VisitorForTypes<Ts&&...> Visitor, typename R = impl::VisitorResultType<Visitor, Ts&&...>>
+    [[nodiscard]] constexpr CRAB_INLINE auto visit(Visitor&& visitor) && -> R {
+      return mem::move(inner).visit([&visitor]<typename S>(S&& stored) -> R {
+        return std::invoke(mem::forward<Visitor>(visitor), impl::unspill(mem::forward<S>(stored)));
+      });
+    }
+
+    /// @}
+
+    /// @name Getters
+    /// @{
+
+    /// Retrieves an optional const reference to the inner value if the current type is the one being asked for
+    template<ty::either<Ts...> T>
+    requires ty::non_reference<T>
+    [[nodiscard]] constexpr auto as() const& -> opt::Option<const T&> {
+      if (not is<T>()) {
+        return {};
+      }
+
+      // SAFETY: as_unchecked valid, we just validated the index.
+      return opt::Option<const T&>{as_unchecked<T>(unsafe)};
+    }
+
+    /// Retrieves an optional mutable reference to the inner value if the current type is the one being asked for
+    template<ty::either<Ts...> T>
+    requires ty::non_reference<T>
+    [[nodiscard]] constexpr auto as() & -> opt::Option<T&> {
+      if (not is<T>()) {
+        return {};
+      }
+
+      // SAFETY: as_unchecked valid, we just validated the index.
+      return opt::Option<T&>{as_unchecked<T>(unsafe)};
+    }
+
+    /// If the requested type is the one contained, this will return an option with the value moved into, note that
+    /// even if this method returns none the storage inside will be destroyed.
+    template<ty::either<Ts...> T>
+    requires ty::non_reference<T>
+    [[nodiscard]] constexpr auto as() && -> opt::Option<T> {
+      if (not is<T>()) {
+        crab::discard(mem::move(inner).template as<Stored<T>>());
+        return {};
+      }
+
+      // SAFETY: as_unchecked valid, we just validated the index.
+      return opt::Option<T>{mem::move(*this).template as_unchecked<T>(unsafe)};
+    }
+
+    /// Returns the reference type requested if the current value is of that type.
+    template<ty::either<Ts...> T>
+    requires ty::is_reference<T>
+    [[nodiscard]] constexpr auto as() & -> opt::Option<T> {
+      return inner.template as<T>();
+    }
+
+    /// Returns the reference type requested if the current value is of that type.
+    template<ty::either<Ts...> T>
+    requires ty::is_reference<T>
+    [[nodiscard]] constexpr auto as() const& -> opt::Option<T> {
+      return inner.template as<T>();
+    }
+
+    /// Returns the reference type requested if the current value is of that type.
+    /// note that after this method is called, this CompactAnyOf is left invalid (this is rvalue qualified)
+    template<ty::either<Ts...> T>
+    requires ty::is_reference<T>
+    [[nodiscard]] constexpr auto as() && -> opt::Option<T> {
+      return mem::move(inner).template as<T>();
+    }
+
+    template<ty::either<Ts...> T>
+    requires ty::is_reference<T>
+    [[nodiscard]] constexpr CRAB_INLINE auto as_unchecked(unsafe_fn) & -> T {
+      return inner.template as_unchecked<T>(unsafe);
+    }
+
+    template<ty::either<Ts...> T>
+    requires ty::is_reference<T>
+    [[nodiscard]] constexpr CRAB_INLINE auto as_unchecked(unsafe_fn) const& -> T {
+      return inner.template as_unchecked<T>(unsafe);
+    }
+
+    template<ty::either<Ts...> T>
+    requires ty::is_reference<T>
+    [[nodiscard]] constexpr CRAB_INLINE auto as_unchecked(unsafe_fn) && -> T {
+      return mem::move(inner).template as_unchecked<T>(unsafe);
+    }
+
+    template<ty::either<Ts...> T>
+    requires ty::non_reference<T>
+    [[nodiscard]] constexpr CRAB_INLINE auto as_unchecked(unsafe_fn) & -> T& {
+      return impl::unspill(inner.template as_unchecked<Stored<T>>(unsafe));
+    }
+
+    template<ty::either<Ts...> T>
+    requires ty::non_reference<T>
+    [[nodiscard]] constexpr CRAB_INLINE auto as_unchecked(unsafe_fn) const& -> const T& {
+      return impl::unspill(inner.template as_unchecked<Stored<T>>(unsafe));
+    }
+
+    template<ty::either<Ts...> T>
+    requires ty::non_reference<T>
+    [[nodiscard]] constexpr CRAB_INLINE auto as_unchecked(unsafe_fn) && -> T {
+      return impl::unspill(mem::move(inner).template as_unchecked<Stored<T>>(unsafe));
+    }
+
+    /// Returns whether this is containing the given type, see AnyOf::is
+    ///
+    /// # Panics
+    /// This function will panic if this CompactAnyOf has been moved.
+    template<ty::either<Ts...> T>
+    [[nodiscard]] constexpr CRAB_INLINE auto is() const -> bool {
+      return inner.template is<Stored<T>>();
+    }
+
+    /// Returns whether this is containing the given type, without checking that it is valid. See AnyOf::is_unchecked
+    template<ty::either<Ts...> T>
+    [[nodiscard]] constexpr CRAB_INLINE auto is_unchecked(unsafe_fn) const -> bool {
+      return inner.template is_unchecked<Stored<T>>(unsafe);
+    }
+
+    /// Gets the index of the currently held type, see AnyOf::get_index
+    ///
+    /// # Panics
+    /// This will only panic if called on a CompactAnyOf that has been moved.
+    [[nodiscard]] constexpr CRAB_INLINE auto get_index() const -> usize {
+      return inner.get_index();
+    }
+
+    /// Returns whether this CompactAnyOf is in a valid state, see AnyOf::is_valid
+    [[nodiscard]] CRAB_INLINE constexpr auto is_valid() const -> bool {
+      return inner.is_valid();
+    }
+
+    /// @}
+
+  private:
+
+    /// Values are held in an AnyOf, which is always the only member (the niche of CompactAnyOf relies on it)
+    /// @internal
+    Inner inner;
+  };
+}
+
+namespace crab::opt {
+  /// Niche for CompactAnyOf, which is the same as the one of the AnyOf it stores its values in
+  /// @ingroup opt
+  template<usize Capacity, typename... Ts>
+  requires has_niche<typename any::CompactAnyOf<Capacity, Ts...>::Inner>
+  struct Niche<any::CompactAnyOf<Capacity, Ts...>> : Niche<typename any::CompactAnyOf<Capacity, Ts...>::Inner> {
+    static_assert(
+      sizeof(any::CompactAnyOf<Capacity, Ts...>) == sizeof(typename any::CompactAnyOf<Capacity, Ts...>::Inner)
+    );
+  };
+}
+
+namespace crab::prelude {
+  using any::CompactAnyOf;
+}
+
+CRAB_PRELUDE_GUARD;
@@ -0,0 +1,259 @@
+/// @file crab/any/VariantVec.hpp
+/// @ingroup any
+
+#pragma once
+
+#include <functional>
+#include <span>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "crab/assertion/check.hpp"
+#include "crab/core.hpp"
+#include "crab/core/unit.hpp"
+#include "crab/mem/forward.hpp"
+#include "crab/mem/move.hpp"
+#include "crab/num/integer.hpp"
+#include "crab/ty/compare.hpp"
+
+#include "crab/any/AnyOf.hpp"
+#include "crab/any/impl/dispatch.hpp"
+#include "crab/any/impl/visitor.hpp"
+
+namespace crab::any {
+
+  /// Growable list of values that are each one of Ts, stored as a separate dense array per type (structure of arrays)
+  /// rather than as an array of AnyOf<Ts...>.
+  ///
+  /// Each value only takes the space of its own type, and processing every value of one type (see for_each_of) is a
+  /// plain loop over a contiguous array, with no per element dispatch. This is the same layout as an archetype in an
+  /// ECS.
+  ///
+  /// If Ordered is true this also keeps an index of the order that values were pushed in, so that they can be accessed
+  /// by their position (see get) and visited in that order. Otherwise, the only order is by type (in the order of Ts),
+  /// and then by the order of insertion within that type.
+  ///
+  /// Values are accessed as an AnyOf<Ts&...> (or AnyOf<const Ts&...>), which can be visited / matched like any other
+  /// AnyOf.
+  ///
+  /// # Examples
+  /// ```cpp
+  /// VariantVec<Circle, Square> shapes;
+  /// shapes.push(Circle{1});
+  /// shapes.push(Square{2});
+  /// shapes.push(Circle{3});
+  ///
+  /// f32 area{0};
+  /// shapes.for_each_of<Circle>([&](const Circle& circle) { area += circle.area(); });
+  /// shapes.for_each_of<Square>([&](const Square& square) { area += square.area(); });
+  /// ```
+  ///
+  /// @ingroup any
+  template<bool Ordered, typename... Ts>
+  class BasicVariantVec final {
+    static_assert(sizeof...(Ts) > 0, "Cannot create a VariantVec with no variants");
+    static_assert((ty::non_reference<Ts> and ...), "Cannot create a VariantVec of references");
+    static_assert(not Ordered or sizeof...(Ts) <= 256, "An OrderedVariantVec indexes its types with a u8");
+
+    /// Position of a value within the partition of its type
+    /// @internal
+    struct Slot final {
+      u32 position;
+      u8 index;
+    };
+
+  public:
+
+    /// The type of a value held in this VariantVec, as a single value
+    using Value = AnyOf<Ts...>;
+
+    /// Mutable view of a value, which refers to it in its partition
+    using View = AnyOf<Ts&...>;
+
+    /// Immutable view of a value, which refers to it in its partition
+    using ConstView = AnyOf<const Ts&...>;
+
+    /// Number of types
+    static constexpr usize NumTypes{sizeof...(Ts)};
+
+    /// Index of T in Ts
+    template<ty::either<Ts...> T>
+    static constexpr usize IndexOf{Value::template IndexOf<T>};
+
+    /// Adds a value to the end of its type's partition
+    template<ty::either<Ts...> T>
+    constexpr auto push(T value) -> T& {
+      return emplace<T>(mem::move(value));
+    }
+
+    /// Moves the value held in the given AnyOf into this VariantVec
+    constexpr auto push(Value value) -> View {
+      return mem::move(value).visit([this]<typename T>(T&& inner) -> View {
+        return View::template from<IndexOf<std::remove_cvref_t<T>>>(push(mem::forward<T>(inner)));
+      });
+    }
+
+    /// Constructs a value of T in place at the end of its partition
+    template<ty::either<Ts...> T, typename... Args>
+    constexpr auto emplace(Args&&... args) -> T& {
+      auto& partition{of_mut<T>()};
+
+      if constexpr (Ordered) {
+        crab_dbg_check(partition.size() < static_cast<u32>(-1), "Too many values in a VariantVec partition");
+        order.push_back(Slot{static_cast<u32>(partition.size()), static_cast<u8>(IndexOf<T>)});
+      }
+
+      return partition.emplace_back(mem::forward<Args>(args)...);
+    }
+
+    /// Reserves space for at least the given number of values of T
+    template<ty::either<Ts...> T>
+    constexpr auto reserve(const usize count) -> void {
+      of_mut<T>().reserve(count);
+    }
+
+    /// Removes every value
+    constexpr auto clear() -> void {
+      std::apply([](auto&... partition) { (partition.clear(), ...); }, partitions);
+
+      if constexpr (Ordered) {
+        order.clear();
+      }
+    }
+
+    /// Total number of values, of all types
+    [[nodiscard]] constexpr auto size() const -> usize {
+      return std::apply([](const auto&... partition) { return (partition.size() + ...); }, partitions);
+    }
+
+    /// Whether there are no values
+    [[nodiscard]] constexpr auto is_empty() const -> bool {
+      return size() == 0;
+    }
+
+    /// Number of values of type T
+    template<ty::either<Ts...> T>
+    [[nodiscard]] constexpr auto count() const -> usize {
+      return of<T>().size();
+    }
+
+    /// Every value of type T, in the order they were added
+    template<ty::either<Ts...> T>
+    [[nodiscard]] constexpr auto of() const -> std::span<const T> {
+      return std::get<IndexOf<T>>(partitions);
+    }
+
+    /// Every value of type T, in the order they were added
+    template<ty::either<Ts...> T>
+    [[nodiscard]] constexpr auto of() -> std::span<T> {
+      return of_mut<T>();
+    }
+
+    /// Calls the function with every value of type T, this is a plain loop over a contiguous array.
+    template<ty::either<Ts...> T, ty::consumer<const T&> F>
+    constexpr auto for_each_of(F&& function) const -> void {
+      for (const T& value: of<T>()) {
+        std::invoke(function, value);
+      }
+    }
+
+    /// Calls the function with every value of type T, this is a plain loop over a contiguous array.
+    template<ty::either<Ts...> T, ty::consumer<T&> F>
+    constexpr auto for_each_of(F&& function) -> void {
+      for (T& value: of_mut<T>()) {
+        std::invoke(function, value);
+      }
+    }
+
+    /// Calls the visitor with every value, one type at a time (in the order of Ts). The visitor must accept every type.
+    template<impl::VisitorForTypes<const Ts&...> Visitor>
+    constexpr auto for_each(Visitor&& visitor) const -> void {
+      (for_each_of<Ts>(visitor), ...);
+    }
+
+    /// Calls the visitor with every value, one type at a time (in the order of Ts). The visitor must accept every type.
+    template<impl::VisitorForTypes<Ts&...> Visitor>
+    constexpr auto for_each(Visitor&& visitor) -> void {
+      (for_each_of<Ts>(visitor), ...);
+    }
+
+    /// Calls the visitor with every value in the order they were pushed, this dispatches on the type of each value.
+    template<impl::VisitorForTypes<const Ts&...> Visitor>
+    requires Ordered
+    constexpr auto for_each_in_order(Visitor&& visitor) const -> void {
+      for (const Slot slot: order) {
+        impl::dispatch<NumTypes, void>(slot.index, [this, &visitor, slot]<usize I>() {
+          std::invoke(visitor, std::get<I>(partitions)[slot.position]);
+        });
+      }
+    }
+
+    /// Calls the visitor with every value in the order they were pushed, this dispatches on the type of each value.
+    template<impl::VisitorForTypes<Ts&...> Visitor>
+    requires Ordered
+    constexpr auto for_each_in_order(Visitor&& visitor) -> void {
+      for (const Slot slot: order) {
+        impl::dispatch<NumTypes, void>(slot.index, [this, &visitor, slot]<usize I>() {
+          std::invoke(visitor, std::get<I>(partitions)[slot.position]);
+        });
+      }
+    }
+
+    /// Gets a view of the value at the given position, in the order they were pushed.
+    ///
+    /// # Panics
+    /// This panics if the position is out of bounds.
+    [[nodiscard]] constexpr auto get(const usize position) const -> ConstView requires Ordered
+    {
+      crab_check(position < order.size(), "VariantVec position out of bounds");
+      const Slot slot{order[position]};
+
+      return impl::dispatch<NumTypes, ConstView>(slot.index, [this, slot]<usize I>() -> ConstView {
+        return ConstView::template from<I>(std::get<I>(partitions)[slot.position]);
+      });
+    }
+
+    /// Gets a view of the value at the given position, in the order they were pushed.
+    ///
+    /// # Panics
+    /// This panics if the position is out of bounds.
+    [[nodiscard]] constexpr auto get(const usize position) -> View requires Ordered
+    {
+      crab_check(position < order.size(), "VariantVec position out of bounds");
+      const Slot slot{order[position]};
+
+      return impl::dispatch<NumTypes, View>(slot.index, [this, slot]<usize I>() -> View {
+        return View::template from<I>(std::get<I>(partitions)[slot.position]);
+      });
+    }
+
+  private:
+
+    template<ty::either<Ts...> T>
+    [[nodiscard]] CRAB_INLINE constexpr auto of_mut() -> std::vector<T>& {
+      return std::get<IndexOf<T>>(partitions);
+    }
+
+    std::tuple<std::vector<Ts>...> partitions;
+
+    CRAB_NO_UNIQUE_ADDRESS std::conditional_t<Ordered, std::vector<Slot>, unit> order;
+  };
+
+  /// Structure of arrays list of values that are each one of Ts, see BasicVariantVec
+  /// @ingroup any
+  template<typename... Ts>
+  using VariantVec = BasicVariantVec<false, Ts...>;
+
+  /// Structure of arrays list of values that are each one of Ts, which also remembers the order values were pushed in.
+  /// See BasicVariantVec
+  /// @ingroup any
+  template<typename... Ts>
+  using OrderedVariantVec = BasicVariantVec<true, Ts...>;
+}
+
+namespace crab::prelude {
+  using any::OrderedVariantVec;
+  using any::VariantVec;
+}
+
+CRAB_PRELUDE_GUARD;
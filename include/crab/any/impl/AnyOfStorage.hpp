@@ -1,39 +1,111 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <memory>
+#include <type_traits>
+#include <utility>
 
 #include "crab/any/impl/Buffer.hpp"
-#include "crab/mem/size_of.hpp"
 #include "crab/mem/address_of.hpp"
 #include "crab/mem/forward.hpp"
 #include "crab/mem/move.hpp"
+#include "crab/ty/classify.hpp"
 #include "crab/ty/construct.hpp"
 
 namespace crab::any::impl {
 
+  /// How an alternative is laid out in an AnyOf, references are held as pointers
+  template<typename T>
+  using StoredAs = std::conditional_t<ty::is_reference<T>, ty::remove_reference<T>*, T>;
+
   template<typename... Ts>
-  constexpr usize ByteSize{std::max({
-    []() {
-      if constexpr (ty::is_reference<Ts>) {
-        return mem::size_of<ty::remove_reference<Ts>*>();
-      } else {
-        return mem::size_of<Ts>();
-      }
-    }()...,
-  })};
+  constexpr usize ByteSize{std::max({sizeof(StoredAs<Ts>)...})};
 
   template<typename... Ts>
-  constexpr usize AlignOf{std::max({
-    []() {
-      if constexpr (ty::is_reference<Ts>) {
-        return alignof(ty::remove_reference<Ts>*);
-      } else {
-        return alignof(Ts);
-      }
-    }()...,
-  })};
+  constexpr usize AlignOf{std::max({alignof(StoredAs<Ts>)...})};
+
+  // The properties below are checked by every AnyOf, so each is a single boolean constant (an atomic constraint) rather
+  // than a fold of concepts. Folds of disjunctions are normalized & compared for subsumption by the compiler, which is
+  // expensive for AnyOf's with many alternatives.
+
+  /// Whether T can be moved in & out of an AnyOf, references are always movable.
+  template<typename T>
+  constexpr bool is_movable{ty::is_reference<T> or ty::movable_object<T>};
+
+  /// Whether T can be copied in & out of an AnyOf, references are not copyable.
+  template<typename T>
+  constexpr bool is_copyable{ty::copyable_object<T>};
+
+  /// Whether every alternative is movable
+  template<typename... Ts>
+  concept all_movable = (is_movable<Ts> and ...);
+
+  /// Whether every alternative is copyable
+  template<typename... Ts>
+  concept all_copyable = (is_copyable<Ts> and ...);
+
+  /// @internal
+  template<typename... Ts>
+  constexpr bool is_trivially_copy_constructible{
+    (is_copyable<Ts> and ...) and ((ty::is_reference<Ts> or std::is_trivially_copy_constructible_v<Ts>) and ...)
+  };
+
+  /// @internal
+  template<typename... Ts>
+  constexpr bool is_trivially_move_constructible{
+    ((ty::is_reference<Ts> or std::is_trivially_move_constructible_v<Ts>) and ...)
+  };
+
+  /// @internal
+  template<typename... Ts>
+  constexpr bool is_trivially_destructible{((ty::is_reference<Ts> or std::is_trivially_destructible_v<Ts>) and ...)};
+
+  /// @internal
+  template<typename... Ts>
+  constexpr bool is_trivially_copy_assignable{
+    is_trivially_copy_constructible<Ts...> and is_trivially_destructible<Ts...>
+    and ((ty::is_reference<Ts> or std::is_trivially_copy_assignable_v<Ts>) and ...)
+  };
+
+  /// @internal
+  template<typename... Ts>
+  constexpr bool is_trivially_move_assignable{
+    is_trivially_move_constructible<Ts...> and is_trivially_destructible<Ts...>
+    and ((ty::is_reference<Ts> or std::is_trivially_move_assignable_v<Ts>) and ...)
+  };
+
+  /// Whether copying an AnyOf<Ts...> can be a plain copy of its bytes, references are held as pointers and so are
+  /// always trivial.
+  template<typename... Ts>
+  concept trivially_copy_constructible = is_trivially_copy_constructible<Ts...>;
+
+  /// Whether moving an AnyOf<Ts...> can be a plain copy of its bytes
+  template<typename... Ts>
+  concept trivially_move_constructible = is_trivially_move_constructible<Ts...>;
+
+  /// Whether an AnyOf<Ts...> needs nothing done to be destroyed
+  template<typename... Ts>
+  concept trivially_destructible = is_trivially_destructible<Ts...>;
+
+  /// Whether copy assigning an AnyOf<Ts...> can be a plain copy of its bytes, which is only the case if every way that
+  /// assignment could go (assign, or destroy & construct) is trivial.
+  template<typename... Ts>
+  concept trivially_copy_assignable = is_trivially_copy_assignable<Ts...>;
+
+  /// Whether move assigning an AnyOf<Ts...> can be a plain copy of its bytes
+  template<typename... Ts>
+  concept trivially_move_assignable = is_trivially_move_assignable<Ts...>;
+
+  /// Whether copying an AnyOf<Ts...> needs to go through each alternative's copy constructor. This excludes the trivial
+  /// case explicitly, as the atomic constraints above do not subsume one another.
+  template<typename... Ts>
+  concept nontrivially_copy_constructible = all_copyable<Ts...> and not trivially_copy_constructible<Ts...>;
+
+  /// Whether copy assigning an AnyOf<Ts...> needs to go through each alternative's copy assignment / constructor.
+  template<typename... Ts>
+  concept nontrivially_copy_assignable = all_copyable<Ts...> and not trivially_copy_assignable<Ts...>;
 
   template<typename T>
   struct AnyOfStorage final {
@@ -119,7 +191,7 @@ namespace crab::any::impl {
 
     template<usize Size, usize Align>
     static auto copy(const Buffer<Size, Align>& from, Buffer<Size, Align>& to) -> void {
-      contruct(to, as_ref(from.buffer));
+      construct(to, as_ref(from));
     }
 
     template<usize Size, usize Align>
@@ -129,33 +201,31 @@ namespace crab::any::impl {
 
     template<usize Size, usize Align>
     static auto copy_assign(const Buffer<Size, Align>& from, Buffer<Size, Align>& to) -> void {
-      contruct(to, as_ref(from.buffer));
+      construct(to, as_ref(from));
     }
   };
 
-  template<typename T>
-  struct AnyOfConstructor {
-  protected:
-
-    auto impl_construct(T&& value, auto& buffer) -> std::type_identity<T> {
-      AnyOfStorage<T>::construct(buffer, mem::forward<T>(value));
-
-      return {};
-    }
-
-    auto impl_insert(T&& value, auto& buffer) -> std::type_identity<T> {
-      AnyOfStorage<T>::construct(buffer, mem::forward<T>(value));
+  /// One candidate of the overload set used to pick which alternative a value converts into
+  template<usize I, typename T>
+  struct AnyOfAlternative {
+    static auto select(T&&) -> std::integral_constant<usize, I>;
+  };
 
-      return {};
-    }
+  template<typename Indices, typename... Ts>
+  struct AnyOfAlternatives;
 
-    template<typename... Args>
-    requires std::constructible_from<T, Args...>
-    auto impl_emplace(std::type_identity<T>, auto& buffer, Args&&... args) -> std::type_identity<T> {
-      AnyOfStorage<T>::construct(buffer, mem::forward<Args>(args)...);
+  /// Overload set with a candidate per alternative, this is only instantiated by AnyOf's converting constructor &
+  /// insert, rather than being inherited by every AnyOf.
+  template<usize... Is, typename... Ts>
+  struct AnyOfAlternatives<std::index_sequence<Is...>, Ts...> : AnyOfAlternative<Is, Ts>... {
+    using AnyOfAlternative<Is, Ts>::select...;
+  };
 
-      return {};
-    }
+  /// Index of the alternative of an AnyOf<Ts...> that a value of type T is converted to, which is the one that T
+  /// converts to best (as if by overload resolution).
+  template<typename T, typename... Ts>
+  constexpr usize converted_index{
+    decltype(AnyOfAlternatives<std::index_sequence_for<Ts...>, Ts...>::select(std::declval<T>()))::value
   };
 
 }
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+#include "crab/boxed/Box.hpp"
+#include "crab/core.hpp"
+#include "crab/mem/forward.hpp"
+#include "crab/mem/move.hpp"
+#include "crab/mem/size_of.hpp"
+#include "crab/num/integer.hpp"
+#include "crab/ty/classify.hpp"
+#include "crab/ty/construct.hpp"
+
+namespace crab::any::impl {
+
+  /// Alternative of a CompactAnyOf that was too large to be stored inline, this holds it in a Box but (unlike Box) is
+  /// copyable if T is, so that spilling an alternative does not change whether the CompactAnyOf can be copied.
+  template<typename T>
+  class Spilled final {
+  public:
+
+    template<typename... Args>
+    requires std::constructible_from<T, Args...>
+    constexpr explicit Spilled(std::in_place_t, Args&&... args): box{boxed::make_box<T>(mem::forward<Args>(args)...)} {}
+
+    constexpr Spilled(Spilled&&) noexcept = default;
+
+    constexpr Spilled(const Spilled& from) requires ty::copy_constructible<T>
+        : box{from.box.clone()} {}
+
+    constexpr ~Spilled() = default;
+
+    constexpr auto operator=(Spilled&&) noexcept -> Spilled& = default;
+
+    constexpr auto operator=(const Spilled& from) -> Spilled& requires ty::copy_constructible<T>
+    {
+      if (&from != this) {
+        box = from.box.clone();
+      }
+      return *this;
+    }
+
+    [[nodiscard]] CRAB_INLINE constexpr auto get() & -> T& {
+      return *box;
+    }
+
+    [[nodiscard]] CRAB_INLINE constexpr auto get() const& -> const T& {
+      return *box;
+    }
+
+    [[nodiscard]] CRAB_INLINE constexpr auto get() && -> T&& {
+      return mem::move(*box);
+    }
+
+  private:
+
+    boxed::Box<T> box;
+  };
+
+  /// Whether T is stored out of line in a CompactAnyOf with the given inline capacity, references are stored as
+  /// pointers and so are never spilled.
+  template<usize Capacity, typename T>
+  constexpr bool spills{ty::non_reference<T> and mem::size_of<T>() > Capacity};
+
+  /// How T is stored inside of a CompactAnyOf with the given inline capacity
+  template<usize Capacity, typename T>
+  using CompactStored = std::conditional_t<spills<Capacity, T>, Spilled<T>, T>;
+
+  /// Gets the value held by an alternative of a CompactAnyOf, with the same qualification as the stored alternative
+  template<typename Stored>
+  [[nodiscard]] CRAB_INLINE constexpr auto unspill(Stored&& stored) -> Stored&& {
+    return mem::forward<Stored>(stored);
+  }
+
+  template<typename T>
+  [[nodiscard]] CRAB_INLINE constexpr auto unspill(Spilled<T>& stored) -> T& {
+    return stored.get();
+  }
+
+  template<typename T>
+  [[nodiscard]] CRAB_INLINE constexpr auto unspill(const Spilled<T>& stored) -> const T& {
+    return stored.get();
+  }
+
+  template<typename T>
+  [[nodiscard]] CRAB_INLINE constexpr auto unspill(Spilled<T>&& stored) -> T&& {
+    return mem::move(stored).get();
+  }
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <utility>
+
+#include "crab/core.hpp"
+#include "crab/core/unreachable.hpp"
+#include "crab/mem/forward.hpp"
+#include "crab/num/integer.hpp"
+
+namespace crab::any::impl {
+
+  /// Largest number of alternatives that are dispatched on with a switch, anything larger uses a table of function
+  /// pointers instead.
+  inline constexpr usize SwitchDispatchLimit{16};
+
+  /// Invokes the I'th alternative of a dispatch
+  template<usize I, typename R, typename F>
+  CRAB_INLINE constexpr auto dispatch_one(F&& function) -> R {
+    return mem::forward<F>(function).template operator()<I>();
+  }
+
+  /// Table of every alternative of a dispatch over N alternatives, the function object is passed along by reference.
+  template<usize N, typename R, typename F>
+  inline constexpr auto dispatch_table{[]<usize... Is>(std::index_sequence<Is...>) {
+    return std::array<R (*)(F&&), N>{&dispatch_one<Is, R, F>...};
+  }(std::make_index_sequence<N>{})};
+
+  /// Calls `function.template operator()<I>()` where I is the given index, which must be less than N. This is the shared
+  /// core of AnyOf's visiting & special members.
+  ///
+  /// Small dispatches are a switch (which compilers lower to a jump table or a few branches), larger ones index a
+  /// constant table of function pointers. Either way there is no bounds check, the index must already be valid.
+  template<usize N, typename R, typename F>
+  [[nodiscard]] CRAB_INLINE constexpr auto dispatch(const usize index, F&& function) -> R {
+    static_assert(N > 0, "Cannot dispatch over no alternatives");
+
+    if constexpr (N <= SwitchDispatchLimit) {
+
+// each case is only instantiated if it is in range
+#define CRAB_DISPATCH_CASE(I)                                                                                          \
+  case I:                                                                                                              \
+    if constexpr ((I) < N) {                                                                                           \
+      return mem::forward<F>(function).template operator()<(I)>();                                                     \
+    }                                                                                                                  \
+    break
+
+      switch (index) {
+        CRAB_DISPATCH_CASE(0);
+        CRAB_DISPATCH_CASE(1);
+        CRAB_DISPATCH_CASE(2);
+        CRAB_DISPATCH_CASE(3);
+        CRAB_DISPATCH_CASE(4);
+        CRAB_DISPATCH_CASE(5);
+        CRAB_DISPATCH_CASE(6);
+        CRAB_DISPATCH_CASE(7);
+        CRAB_DISPATCH_CASE(8);
+        CRAB_DISPATCH_CASE(9);
+        CRAB_DISPATCH_CASE(10);
+        CRAB_DISPATCH_CASE(11);
+        CRAB_DISPATCH_CASE(12);
+        CRAB_DISPATCH_CASE(13);
+        CRAB_DISPATCH_CASE(14);
+        CRAB_DISPATCH_CASE(15);
+        default: break;
+      }
+
+#undef CRAB_DISPATCH_CASE
+
+      static_assert(SwitchDispatchLimit == 16, "Dispatch switch must have a case for every index up to its limit");
+      crab::unreachable();
+    } else {
+      return dispatch_table<N, R, F>[index](mem::forward<F>(function));
+    }
+  }
+}
@@ -1,6 +1,10 @@
 #pragma once
 
+#include <array>
 #include <type_traits>
+#include <utility>
+#include "crab/any/forward.hpp"
+#include "crab/num/integer.hpp"
 #include "crab/ty/functor.hpp"
 
 namespace crab::any::impl {
@@ -11,4 +15,102 @@ namespace crab::any::impl {
   template<typename Visitor, typename... Ts>
   requires VisitorForTypes<Visitor, Ts...>
   using VisitorResultType = std::common_type_t<ty::functor_result<Visitor, Ts>...>;
+
+  /// Whether T is an AnyOf
+  template<typename T>
+  constexpr bool is_any_of{false};
+
+  template<typename... Ts>
+  constexpr bool is_any_of<AnyOf<Ts...>>{true};
+
+  /// Whether T is an AnyOf, with any reference / cv qualification
+  template<typename T>
+  concept any_of = is_any_of<std::remove_cvref_t<T>>;
+
+  /// The type that the I'th alternative of an AnyOf is visited as, when the AnyOf itself is passed as Any (as deduced
+  /// by a forwarding reference). This is the same as a single visit, eg. a const lvalue AnyOf<Ts...> is visited as
+  /// 'const Ts&...'.
+  template<any_of Any, usize I>
+  using VisitedType = std::conditional_t<
+    std::is_lvalue_reference_v<Any>,
+    std::conditional_t<
+      std::is_const_v<std::remove_reference_t<Any>>,
+      const typename std::remove_cvref_t<Any>::template NthType<I>&,
+      typename std::remove_cvref_t<Any>::template NthType<I>&>,
+    typename std::remove_cvref_t<Any>::template NthType<I>&&>;
+
+  /// Helper for folding std::common_type over many types without recursively instantiating it for each one
+  template<typename T>
+  struct CommonTypeOf final {
+    using type = T;
+
+    template<typename U>
+    friend auto operator|(CommonTypeOf, CommonTypeOf<U>) -> CommonTypeOf<std::common_type_t<T, U>>;
+  };
+
+  /// Flattened dispatch over every combination of alternatives of several AnyOf's, the combinations are numbered in
+  /// row major order (the first AnyOf is the most significant).
+  template<typename Visitor, any_of... Anys>
+  struct MultiVisit final {
+    static_assert(sizeof...(Anys) > 0, "Must visit at least one AnyOf");
+
+    /// Number of alternatives of each AnyOf
+    static constexpr std::array<usize, sizeof...(Anys)> Sizes{std::remove_cvref_t<Anys>::NumTypes...};
+
+    /// Number of different combinations of alternatives
+    static constexpr usize Combinations{(std::remove_cvref_t<Anys>::NumTypes * ...)};
+
+    /// Index of the alternative of the J'th AnyOf in the K'th combination
+    template<usize K, usize J>
+    static constexpr usize IndexIn{[] {
+      usize stride{1};
+      for (usize i = J + 1; i < Sizes.size(); i++) {
+        stride *= Sizes[i];
+      }
+      return K / stride % Sizes[J];
+    }()};
+
+    /// Alternatives that make up the K'th combination
+    template<usize K, typename = std::index_sequence_for<Anys...>>
+    struct Combination;
+
+    template<usize K, usize... Js>
+    struct Combination<K, std::index_sequence<Js...>> final {
+      /// Whether the visitor accepts this combination
+      static constexpr bool accepted{ty::consumer<Visitor, VisitedType<Anys, IndexIn<K, Js>>...>};
+
+      /// Result of visiting this combination, this is only complete if it is accepted
+      using Invoke = std::invoke_result<Visitor, VisitedType<Anys, IndexIn<K, Js>>...>;
+    };
+
+    template<typename = std::make_index_sequence<Combinations>>
+    struct AllCombinations;
+
+    template<usize... Ks>
+    struct AllCombinations<std::index_sequence<Ks...>> final {
+      /// Whether the visitor accepts every combination
+      static constexpr bool accepted{(Combination<Ks>::accepted and ...)};
+    };
+
+    template<typename = std::make_index_sequence<Combinations>>
+    struct CommonResult;
+
+    template<usize... Ks>
+    struct CommonResult<std::index_sequence<Ks...>> final {
+      /// Common result of visiting any combination, only valid if every one is accepted
+      using type = std::common_type_t<
+        typename decltype((CommonTypeOf<typename Combination<Ks>::Invoke::type>{} | ...))::type>;
+    };
+
+    /// Whether the visitor accepts every combination
+    static constexpr bool exhaustive{AllCombinations<>::accepted};
+  };
+
+  /// Whether the visitor can accept every combination of alternatives of the given AnyOf's (as forwarding references)
+  template<typename Visitor, typename... Anys>
+  concept VisitorForAnyOfs = (any_of<Anys> and ...) and MultiVisit<Visitor, Anys...>::exhaustive;
+
+  template<typename Visitor, typename... Anys>
+  requires VisitorForAnyOfs<Visitor, Anys...>
+  using MultiVisitResultType = typename MultiVisit<Visitor, Anys...>::template CommonResult<>::type;
 }
@@ -0,0 +1,71 @@
+/// @file crab/any/visit.hpp
+/// @ingroup any
+
+#pragma once
+
+#include <functional>
+#include <utility>
+#include "crab/core.hpp"
+#include "crab/core/unsafe.hpp"
+#include "crab/mem/forward.hpp"
+
+#include "crab/any/AnyOf.hpp"
+#include "crab/any/impl/dispatch.hpp"
+#include "crab/any/impl/visitor.hpp"
+
+namespace crab::any {
+
+  /// Visits several AnyOf's at once, calling the visitor with the value held by each of them (in order).
+  ///
+  /// Every combination of alternatives is numbered at compile time, so this is a single dispatch on the combined index
+  /// rather than one dispatch per AnyOf (as nesting AnyOf::match calls would do). The visitor must accept every
+  /// combination of alternatives, each is passed the same way a single visit would (eg. a const AnyOf<Ts...>& is
+  /// visited as 'const Ts&'). Visiting an rvalue AnyOf moves its value into the visitor & leaves it invalid.
+  ///
+  /// # Panics
+  /// This panics if any of the given AnyOf's are invalid (moved-from).
+  ///
+  /// # Examples
+  /// ```cpp
+  /// struct Idle {};
+  /// struct Running { u32 ticks; };
+  ///
+  /// struct Start {};
+  /// struct Tick {};
+  ///
+  /// AnyOf<Idle, Running> state{Idle{}};
+  /// const AnyOf<Start, Tick> message{Tick{}};
+  ///
+  /// state = crab::any::visit(
+  ///   crab::cases{
+  ///     [](Idle, const Start&) -> AnyOf<Idle, Running> { return Running{0}; },
+  ///     [](Running running, const Tick&) -> AnyOf<Idle, Running> { return Running{running.ticks + 1}; },
+  ///     [](auto current, const auto&) -> AnyOf<Idle, Running> { return current; },
+  ///   },
+  ///   mem::move(state),
+  ///   message
+  /// );
+  /// ```
+  template<typename Visitor, impl::any_of... Anys>
+  requires impl::VisitorForAnyOfs<Visitor, Anys&&...>
+  [[nodiscard]] constexpr auto visit(Visitor&& visitor, Anys&&... anys)
+    -> impl::MultiVisitResultType<Visitor, Anys&&...> {
+    using Dispatch = impl::MultiVisit<Visitor, Anys&&...>;
+    using R = impl::MultiVisitResultType<Visitor, Anys&&...>;
+
+    usize combination{0};
+    ((combination = combination * std::remove_cvref_t<Anys>::NumTypes + anys.get_index()), ...);
+
+    return impl::dispatch<Dispatch::Combinations, R>(combination, [&]<usize K>() -> R {
+      return [&]<usize... Js>(std::index_sequence<Js...>) -> R {
+        return std::invoke(
+          mem::forward<Visitor>(visitor),
+          mem::forward<Anys>(anys)
+            .template as_unchecked<typename std::remove_cvref_t<Anys>::template NthType<Dispatch::template IndexIn<K, Js>>>(
+              unsafe
+            )...
+        );
+      }(std::index_sequence_for<Anys...>{});
+    });
+  }
+}
@@ -46,7 +46,11 @@ namespace crab {
           stream << x;
           return std::move(stream).str();
         } else {
+#if CRAB_RTTI
           return typeid(T).name();
+#else
+          return "<unformattable>";
+#endif
         }
       }
     }(obj);
@@ -5,7 +5,10 @@
 // ReSharper disable CppNonExplicitConversionOperator
 #pragma once
 #include <concepts>
+#include <cstddef>
+#include <algorithm>
 #include <iostream>
+#include <span>
 
 #include <utility>
 
@@ -17,8 +20,10 @@
 #include "crab/ref/ref.hpp"
 #include "crab/ref/casts.hpp"
 #include "crab/ref/from_ptr.hpp"
+#include "crab/ref/type_id.hpp"
 
 #include "crab/opt/forward.hpp"
+#include "crab/opt/niche.hpp"
 
 #include "crab/boxed/forward.hpp"
 #include "crab/boxed/impl/BoxStorage.hpp"
@@ -27,12 +32,14 @@
 
 namespace crab {
 
-  /// Storage type specialization for Box<T>
+  /// Storage type specialization for Box<T, A>, a box whose allocator cannot be default constructed has no value to
+  /// use for none and so falls back to the generic storage.
   /// @ingroup boxed
-  template<typename T>
-  struct opt::Storage<::crab::boxed::Box<T>> final {
+  template<typename T, typename A>
+  requires std::default_initializable<A>
+  struct opt::Storage<::crab::boxed::Box<T, A>> final {
     /// @hideinitializer
-    using type = boxed::impl::BoxStorage<T>;
+    using type = boxed::impl::BoxStorage<T, A>;
   };
 
   namespace boxed {
@@ -48,6 +55,11 @@ namespace crab {
     /// destroy' state once moved, you must take on the weaker invariant and use Option<Box<T>> to explicitly allowed
     /// Box<T> to be none.
     ///
+    /// The allocator 'A' defaults to mem::Global (new / delete), any standard allocator can be used instead with
+    /// make_box_in to place the value in an arena or pool. A stateless allocator adds no size to the box. Note that only
+    /// a Box<T> using the global allocator can be converted into a Box of one of T's base classes, as a standard
+    /// allocator needs to be given back the exact type it allocated.
+    ///
     /// This is a replacement for std::unique_ptr, with two key differences:
     ///
     /// - Prevents Interior Mutability, being passed a const Box<T>& means dealing
@@ -76,9 +88,10 @@ namespace crab {
     ///
     /// @ingroup prelude
     /// @ingroup boxed
-    template<typename T>
+    template<typename T, typename A>
     class Box {
       T* obj;
+      CRAB_NO_UNIQUE_ADDRESS A alloc;
 
       static_assert(
         not crab::ty::is_const<T>,
@@ -87,23 +100,35 @@ namespace crab {
         "Box<T>"
       );
 
+      static_assert(mem::allocator<A>, "Box<T, A> requires A to be mem::Global or a standard allocator");
+
       // SizeType size;
-      CRAB_INLINE constexpr explicit Box(T* const from): obj(from) {}
+      CRAB_INLINE constexpr explicit Box(T* const from, A alloc = A{}): obj(from), alloc{mem::move(alloc)} {}
+
+      /// Byte offset of the pointer, for the niche of Box<T>
+      [[nodiscard]] static CRAB_CONSTEVAL auto ptr_offset() -> usize {
+        return offsetof(Box, obj);
+      }
 
       /**
        * Deletes the inner content, leaving this value partially formed
        */
       CRAB_INLINE constexpr auto drop() -> void {
-        if constexpr (crab::ty::array<T>) {
+        if constexpr (crab::ty::array<T> and std::same_as<A, mem::Global>) {
           delete[] obj;
         } else {
-          delete obj;
+          mem::alloc_delete(alloc, obj);
         }
       }
 
     public:
 
-      friend struct impl::BoxStorage<T>;
+      template<typename, typename>
+      friend class Box;
+
+      friend struct impl::BoxStorage<T, A>;
+
+      friend struct opt::Niche<Box>;
 
       /// Wraps pointer and assumes ownership.
       ///
@@ -111,10 +136,21 @@ namespace crab {
       /// This function has no way of knowing if the pointer passed is actually on
       /// the heap or if something else has ownership, therefor 'unchecked' and it is
       /// the responsibility of the caller to make sure. Incorrect use of this method will result in undefined behavior.
-      [[nodiscard]] CRAB_INLINE constexpr static auto from_raw(unsafe_fn, T* const ref) -> Box {
+      [[nodiscard]] CRAB_INLINE constexpr static auto from_raw(unsafe_fn, T* const ref) -> Box
+        requires std::default_initializable<A>
+      {
         return Box{ref};
       };
 
+      /// Wraps pointer and assumes ownership, the pointer will be freed with the given allocator.
+      ///
+      /// # Safety
+      /// The pointer must have been allocated and constructed (as exactly a T) with an allocator equal to 'alloc', and
+      /// must not be owned by anything else.
+      [[nodiscard]] CRAB_INLINE constexpr static auto from_raw(unsafe_fn, T* const ref, A alloc) -> Box {
+        return Box{ref, mem::move(alloc)};
+      };
+
       /// Gives up ownership & opts out of RAII, giving you the raw
       /// pointer to manage yourself. (equivalent of std::unique_ptr<T>::release)
       [[nodiscard]] CRAB_INLINE constexpr auto into_raw(const SourceLocation loc = SourceLocation::current()) && -> T* {
@@ -128,10 +164,11 @@ namespace crab {
       Box(const Box&) = delete;
 
       /// Move construction from box, leaves 'from' in an invalid state, after it is only safe to destroy or reassign.
-      CRAB_INLINE constexpr Box(Box&& from) noexcept: obj{mem::take(from.obj)} {}
+      CRAB_INLINE constexpr Box(Box&& from) noexcept: obj{mem::take(from.obj)}, alloc{mem::move(from.alloc)} {}
 
       /// Conversion constructor of Box<Derived> to downcast to Box<Base>
       template<std::derived_from<T> Derived>
+      requires std::same_as<A, mem::Global>
       CRAB_INLINE constexpr Box(Box<Derived> from, const SourceLocation loc = SourceLocation::current()):
           Box{mem::move(from).into_raw()} {
         crab_check_with_location(obj != nullptr, loc, "Invalid Box, moved from invalid box.");
@@ -198,12 +235,14 @@ namespace crab {
 
         drop();
         obj = mem::take(rhs.obj);
+        mem::replace_allocator(alloc, mem::move(rhs.alloc));
 
         return *this;
       }
 
       /// Move assignment from a Box of a derived type, this will perform the required upcast
       template<std::derived_from<T> Derived>
+      requires std::same_as<A, mem::Global>
       CRAB_INLINE constexpr auto operator=(Box<Derived> rhs) noexcept -> Box& {
         if (obj == ref::implicit_cast<T*>(rhs.as_ptr())) {
           return *this;
@@ -264,10 +303,17 @@ namespace crab {
         return *as_ptr(loc);
       }
 
+      /// Gets the allocator this box frees its value with
+      [[nodiscard]] CRAB_INLINE constexpr auto allocator() const -> const A& {
+        return alloc;
+      }
+
       ///  Performs a deep copy of the value inside, this is only possible if it valid to copy construct an instance of
+      /// T. The copy is made with (a copy of) the same allocator.
       [[nodiscard]] CRAB_INLINE constexpr auto clone() const& -> Box requires ty::copy_constructible<T>
       {
-        return boxed::make_box<T, const T&>(as_ref());
+        A copy{alloc};
+        return Box{mem::alloc_new<T>(copy, as_ref()), mem::move(copy)};
       }
 
       /// Performs a deep copy of the value inside, this is only possible if it valid to copy construct an instance of
@@ -292,14 +338,14 @@ namespace crab {
       template<std::derived_from<T> Derived>
       [[nodiscard]] CRAB_INLINE constexpr auto downcast(const SourceLocation loc = SourceLocation::current()) const
         -> opt::Option<const Derived&> {
-        return ref::from_ptr(dynamic_cast<const Derived*>(as_ptr(loc)));
+        return ref::from_ptr(ref::dynamic_downcast<const Derived>(as_ptr(loc)));
       }
 
       /// Attempts to downcast the pointer
       template<std::derived_from<T> Derived>
       [[nodiscard]] CRAB_INLINE constexpr auto downcast(const SourceLocation loc = SourceLocation::current())
         -> opt::Option<Derived&> {
-        return ref::from_ptr(dynamic_cast<Derived*>(as_ptr_mut(loc)));
+        return ref::from_ptr(ref::dynamic_downcast<Derived>(as_ptr_mut(loc)));
       }
 
       /// Upcasts to a base type
@@ -320,8 +366,9 @@ namespace crab {
       /// This function will either transfer ownership to a returned Some value, or
       /// this data will be deleted entirely, invalidating this object & returning crab::none
       template<std::derived_from<T> Derived>
+      requires std::same_as<A, mem::Global>
       [[nodiscard]] CRAB_INLINE constexpr auto downcast_lossy() && -> opt::Option<Box<Derived>> {
-        auto* ptr{dynamic_cast<Derived*>(as_ptr_mut())};
+        auto* ptr{ref::dynamic_downcast<Derived>(as_ptr_mut())};
 
         if (ptr == nullptr) {
           drop();
@@ -340,9 +387,219 @@ namespace crab {
       }
     };
 
+    /// Owned Pointer (RAII) to a heap allocated array of T, along with its length. This is the slice counterpart to
+    /// Box<T>, and follows the same moved-from rules (a moved-from Box<T[]> is only safe to reassign or destroy).
+    ///
+    /// Unlike std::unique_ptr<T[]> the length is stored alongside the pointer, so the contents can always be viewed as a
+    /// std::span.
+    ///
+    /// # Examples
+    /// ```cpp
+    ///  Box<u32[]> values = crab::make_box<u32[]>(16);
+    ///
+    ///  for (u32& value: values) {
+    ///    value = 10;
+    ///  }
+    ///
+    ///  std::span<const u32> view = values.as_span();
+    /// ```
+    ///
+    /// @ingroup boxed
+    template<typename T, typename A>
+    class Box<T[], A> {
+      T* obj;
+      usize length;
+      CRAB_NO_UNIQUE_ADDRESS A alloc;
+
+      static_assert(
+        not crab::ty::is_const<T>,
+        "Box<T[]> does not support const undirected types, switch "
+        "Box<const T[]> into "
+        "Box<T[]>"
+      );
+
+      static_assert(mem::allocator<A>, "Box<T[], A> requires A to be mem::Global or a standard allocator");
+
+      CRAB_INLINE constexpr explicit Box(T* const from, const usize length = 0, A alloc = A{}):
+          obj(from), length{length}, alloc{mem::move(alloc)} {}
+
+      /// Byte offset of the pointer, for the niche of Box<T[]>
+      [[nodiscard]] static CRAB_CONSTEVAL auto ptr_offset() -> usize {
+        return offsetof(Box, obj);
+      }
+
+      /**
+       * Deletes the inner content, leaving this value partially formed
+       */
+      CRAB_INLINE constexpr auto drop() -> void {
+        mem::alloc_delete_array(alloc, obj, length);
+      }
+
+    public:
+
+      friend struct impl::BoxStorage<T[], A>;
+
+      friend struct opt::Niche<Box>;
+
+      /// Wraps pointer to an array of 'length' elements and assumes ownership.
+      ///
+      /// # Safety
+      /// The pointer must have been allocated with new[] (with exactly 'length' elements), and must not be owned by
+      /// anything else.
+      [[nodiscard]] CRAB_INLINE constexpr static auto from_raw(unsafe_fn, T* const ref, const usize length) -> Box
+        requires std::default_initializable<A>
+      {
+        return Box{ref, length};
+      };
+
+      /// Wraps pointer to an array of 'length' elements and assumes ownership, the array will be freed with the given
+      /// allocator.
+      ///
+      /// # Safety
+      /// The pointer must have been allocated with an allocator equal to 'alloc' (with exactly 'length' constructed
+      /// elements), and must not be owned by anything else.
+      [[nodiscard]] CRAB_INLINE constexpr static auto from_raw(unsafe_fn, T* const ref, const usize length, A alloc)
+        -> Box {
+        return Box{ref, length, mem::move(alloc)};
+      };
+
+      /// Allocates a new array with the given allocator and copies every element of the given span into it.
+      [[nodiscard]] constexpr static auto copy_from(const std::span<const T> values, A alloc = A{}) -> Box
+        requires(ty::default_constructible<T> and ty::copy_assignable<T>)
+      {
+        T* const data{mem::alloc_new_array<T>(alloc, values.size())};
+        std::copy(values.begin(), values.end(), data);
+        return Box{data, values.size(), mem::move(alloc)};
+      }
+
+      /// Gives up ownership & opts out of RAII, giving you the raw pointer (allocated with new[]) to manage yourself.
+      /// Note the length is not returned, use Box::size beforehand if needed.
+      [[nodiscard]] CRAB_INLINE constexpr auto into_raw(const SourceLocation loc = SourceLocation::current()) && -> T* {
+        crab_check_with_location(obj != nullptr, loc, "Invalid Use of Moved Box<T[]>.");
+        length = 0;
+        return mem::take(obj);
+      }
+
+      /// A box cannot be empty.
+      Box() = delete;
+
+      /// A box cannot be trivially copied
+      Box(const Box&) = delete;
+
+      /// Move construction from box, leaves 'from' in an invalid state, after it is only safe to destroy or reassign.
+      CRAB_INLINE constexpr Box(Box&& from) noexcept:
+          obj{mem::take(from.obj)}, length{mem::take(from.length)}, alloc{mem::move(from.alloc)} {}
+
+      /// Destructor of Box<T[]>
+      CRAB_INLINE constexpr ~Box() {
+        drop();
+      }
+
+      /// Implicit conversion to a mutable view of the elements, alias of as_span_mut.
+      CRAB_INLINE constexpr operator std::span<T>() {
+        return as_span_mut();
+      }
+
+      /// Implicit conversion to a view of the elements, alias of as_span.
+      CRAB_INLINE constexpr operator std::span<const T>() const {
+        return as_span();
+      }
+
+      auto operator=(const Box&) -> void = delete;
+
+      /// Move assignment
+      CRAB_INLINE constexpr auto operator=(Box&& rhs) noexcept -> Box& {
+        if (rhs.obj == obj) {
+          return *this;
+        }
+
+        drop();
+        obj = mem::take(rhs.obj);
+        length = mem::take(rhs.length);
+        mem::replace_allocator(alloc, mem::move(rhs.alloc));
+
+        return *this;
+      }
+
+      /// Index access, bounds checked in debug builds
+      [[nodiscard]] CRAB_INLINE constexpr auto operator[](const usize index) -> T& {
+        crab_dbg_check(index < size(), "Box<T[]> index out of bounds");
+        return as_ptr_mut()[index];
+      }
+
+      /// Index access, bounds checked in debug builds
+      [[nodiscard]] CRAB_INLINE constexpr auto operator[](const usize index) const -> const T& {
+        crab_dbg_check(index < size(), "Box<T[]> index out of bounds");
+        return as_ptr()[index];
+      }
+
+      /// Number of elements in the array
+      [[nodiscard]] CRAB_INLINE constexpr auto size() const -> usize {
+        return length;
+      }
+
+      /// Whether the array has no elements
+      [[nodiscard]] CRAB_INLINE constexpr auto is_empty() const -> bool {
+        return length == 0;
+      }
+
+      /// Gets the allocator this box frees its elements with
+      [[nodiscard]] CRAB_INLINE constexpr auto allocator() const -> const A& {
+        return alloc;
+      }
+
+      /// Gets a pointer to the first element
+      [[nodiscard]] CRAB_INLINE constexpr auto as_ptr_mut(const SourceLocation loc = SourceLocation::current()) -> T* {
+        crab_dbg_check_with_location(obj != nullptr, loc, "Invalid Use of Moved Box<T[]>.");
+        return obj;
+      }
+
+      /// Gets a pointer to the first element
+      [[nodiscard]] CRAB_INLINE constexpr auto as_ptr(const SourceLocation loc = SourceLocation::current()) const
+        -> const T* {
+        crab_dbg_check_with_location(obj != nullptr, loc, "Invalid Use of Moved Box<T[]>.");
+        return obj;
+      }
+
+      /// Gets a mutable view of the elements
+      [[nodiscard]] CRAB_INLINE constexpr auto as_span_mut(const SourceLocation loc = SourceLocation::current())
+        -> std::span<T> {
+        return {as_ptr_mut(loc), length};
+      }
+
+      /// Gets a view of the elements
+      [[nodiscard]] CRAB_INLINE constexpr auto as_span(const SourceLocation loc = SourceLocation::current()) const
+        -> std::span<const T> {
+        return {as_ptr(loc), length};
+      }
+
+      [[nodiscard]] CRAB_INLINE constexpr auto begin() -> T* {
+        return as_ptr_mut();
+      }
+
+      [[nodiscard]] CRAB_INLINE constexpr auto begin() const -> const T* {
+        return as_ptr();
+      }
+
+      [[nodiscard]] CRAB_INLINE constexpr auto end() -> T* {
+        return as_ptr_mut() + length;
+      }
+
+      [[nodiscard]] CRAB_INLINE constexpr auto end() const -> const T* {
+        return as_ptr() + length;
+      }
+
+      /// Performs a deep copy of every element into a new allocation, made with (a copy of) the same allocator
+      [[nodiscard]] CRAB_INLINE constexpr auto clone() const& -> Box
+        requires(ty::default_constructible<T> and ty::copy_assignable<T>)
+      {
+        return copy_from(as_span(), alloc);
+      }
+    };
+
     /// Specialization for fmt to be able to format a Box<T> if T is formattable.
-    template<typename T>
-    [[nodiscard]] auto format_as(const Box<T>& box) -> const T& {
+    template<typename T, typename A>
+    [[nodiscard]] auto format_as(const Box<T, A>& box) -> const T& {
       return box.as_ref();
     }
 
@@ -354,9 +611,55 @@ namespace crab {
     [[nodiscard]] CRAB_INLINE constexpr static auto make_box(Args&&... args) -> Box<T> {
       return Box<T>::from_raw(unsafe, new T(std::forward<Args>(args)...));
     }
+
+    /// Makes a new array of 'length' value-initialized elements on the heap, eg. make_box<u32[]>(16)
+    /// @ingroup boxed
+    template<typename T>
+    requires std::is_unbounded_array_v<T>
+    [[nodiscard]] CRAB_INLINE constexpr static auto make_box(const usize length) -> Box<T> {
+      using Element = std::remove_extent_t<T>;
+      return Box<T>::from_raw(unsafe, new Element[length](), length);
+    }
+
+    /// Makes a new instance of type T with the given allocator, the values passed will be forwarded into the
+    /// constructor of T. The box frees the value with (a copy of) the same allocator.
+    ///
+    /// ```cpp
+    ///  std::pmr::monotonic_buffer_resource arena;
+    ///  Box<u32, std::pmr::polymorphic_allocator<>> value = crab::make_box_in<u32>(
+    ///    std::pmr::polymorphic_allocator<>{&arena},
+    ///    10
+    ///  );
+    /// ```
+    /// @ingroup boxed
+    template<ty::complete_type T, mem::allocator A, typename... Args>
+    requires std::constructible_from<T, Args...>
+    [[nodiscard]] CRAB_INLINE constexpr auto make_box_in(A alloc, Args&&... args) -> Box<T, A> {
+      T* const value{mem::alloc_new<T>(alloc, std::forward<Args>(args)...)};
+      return Box<T, A>::from_raw(unsafe, value, mem::move(alloc));
+    }
+
+    /// Makes a new array of 'length' value-initialized elements with the given allocator, eg.
+    /// make_box_in<u32[]>(alloc, 16)
+    /// @ingroup boxed
+    template<typename T, mem::allocator A>
+    requires std::is_unbounded_array_v<T>
+    [[nodiscard]] CRAB_INLINE constexpr auto make_box_in(A alloc, const usize length) -> Box<T, A> {
+      using Element = std::remove_extent_t<T>;
+
+      Element* const elements{mem::alloc_new_array<Element>(alloc, length)};
+      return Box<T, A>::from_raw(unsafe, elements, length, mem::move(alloc));
+    }
   }
 
+  /// A valid Box is never null, a moved-from box is null but destroying it does nothing.
+  /// @ingroup boxed
+  template<typename T, typename A>
+  struct opt::Niche<boxed::Box<T, A>> :
+      opt::BitNiche<boxed::Box<T, A>, const void*, nullptr, boxed::Box<T, A>::ptr_offset()> {};
+
   using boxed::make_box;
+  using boxed::make_box_in;
 
 }
 
@@ -0,0 +1,373 @@
+/// @file crab/boxed/InlineBox.hpp
+/// @ingroup boxed
+
+// NOLINTBEGIN(*explicit*)
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#include "crab/assertion/check.hpp"
+#include "crab/core.hpp"
+#include "crab/mem/forward.hpp"
+#include "crab/mem/move.hpp"
+#include "crab/mem/take.hpp"
+#include "crab/ref/from_ptr.hpp"
+#include "crab/ref/type_id.hpp"
+
+#include "crab/opt/forward.hpp"
+#include "crab/opt/niche.hpp"
+
+#include "crab/boxed/Box.hpp"
+#include "crab/boxed/forward.hpp"
+#include "crab/boxed/impl/InlineBoxStorage.hpp"
+
+namespace crab {
+
+  /// Storage type specialization for InlineBox<T, Capacity, Align>
+  /// @ingroup boxed
+  template<typename T, usize Capacity, usize Align>
+  struct opt::Storage<::crab::boxed::InlineBox<T, Capacity, Align>> final {
+    /// @hideinitializer
+    using type = boxed::impl::InlineBoxStorage<T, Capacity, Align>;
+  };
+
+  namespace boxed {
+    namespace impl {
+      /// Type erased operations for the value inside of an InlineBox, these are given the address of the complete
+      /// object (not of the T the box points to) so that they do not depend on what type the box was upcasted to.
+      /// @internal
+      struct InlineBoxVTable final {
+        /// Move constructs the value into 'to' then destroys the one at 'from', this is nullptr for a value on the heap
+        /// (which is moved by handing over its pointer).
+        void (*relocate)(void* to, void* from);
+
+        /// Destroys the value, freeing it if it is on the heap.
+        void (*drop)(void* value);
+      };
+
+      template<typename U>
+      inline constexpr InlineBoxVTable inline_vtable{
+        [](void* const to, void* const from) {
+          U* const value{static_cast<U*>(from)};
+          std::construct_at(static_cast<U*>(to), mem::move(*value));
+          std::destroy_at(value);
+        },
+        [](void* const value) { std::destroy_at(static_cast<U*>(value)); },
+      };
+
+      template<typename U>
+      inline constexpr InlineBoxVTable heap_vtable{
+        nullptr,
+        [](void* const value) { delete static_cast<U*>(value); },
+      };
+
+      /// Whether a value of type U may be held by a box of T, either T itself or a class derived from it.
+      template<typename U, typename T>
+      concept boxable_as = std::same_as<U, T> or std::derived_from<U, T>;
+    }
+
+    /// Owned (RAII) polymorphic value of T that is stored inline when it fits, and on the heap otherwise. This is a
+    /// small-buffer counterpart to Box<T>, meant for small polymorphic objects (eg. strategies or handlers) that are
+    /// made and dropped often enough for the allocation to matter.
+    ///
+    /// Any type derived from T of at most 'Capacity' bytes and 'Align' alignment (whose move constructor is noexcept)
+    /// is constructed inside of the box itself, anything else falls back to a heap allocation. Moving an inline value
+    /// relocates it through a thunk stored alongside it, so T does not need a virtual destructor nor any virtual
+    /// move support.
+    ///
+    /// Like Box<T>, a moved-from InlineBox is only safe to reassign or destroy, which is also what lets Option of an
+    /// InlineBox be the same size as the box.
+    ///
+    /// # Examples
+    /// ```cpp
+    ///  struct Strategy {
+    ///    virtual ~Strategy() = default;
+    ///    virtual auto run() -> void = 0;
+    ///  };
+    ///
+    ///  struct Fast final : Strategy {
+    ///    auto run() -> void override {}
+    ///  };
+    ///
+    ///  InlineBox<Strategy, 16> strategy = crab::make_inline_box<Strategy, 16, Fast>();
+    ///  strategy->run();
+    /// ```
+    ///
+    /// @ingroup boxed
+    template<typename T, usize Capacity, usize Align = alignof(std::max_align_t)>
+    class InlineBox {
+      static_assert(not crab::ty::is_const<T>, "InlineBox<T> does not support const types, use InlineBox<T>");
+
+      // a value on the heap keeps its complete object pointer in the buffer
+      static_assert(Capacity >= sizeof(void*), "InlineBox capacity must be able to hold at least a pointer");
+      static_assert(Align >= alignof(void*), "InlineBox alignment must be able to hold at least a pointer");
+
+      alignas(Align) std::array<std::byte, Capacity> buffer;
+      T* obj{nullptr};
+      const impl::InlineBoxVTable* vtable{nullptr};
+
+      /// Moved-from / none state
+      CRAB_INLINE constexpr InlineBox() = default;
+
+      /// Byte offset of the pointer, for the niche of InlineBox<T>
+      [[nodiscard]] static CRAB_CONSTEVAL auto ptr_offset() -> usize {
+        return offsetof(InlineBox, obj);
+      }
+
+      template<typename, usize, usize>
+      friend class InlineBox;
+
+      friend struct impl::InlineBoxStorage<T, Capacity, Align>;
+
+      friend struct opt::Niche<InlineBox>;
+
+    public:
+
+      /// Whether a value of type U would be stored inline in this box (as opposed to on the heap).
+      template<typename U>
+      static constexpr bool fits_inline{
+        sizeof(U) <= Capacity and alignof(U) <= Align and std::is_nothrow_move_constructible_v<U>
+      };
+
+      /// Constructs a U (which is T or derives from it) from the given arguments inside of a new box.
+      template<impl::boxable_as<T> U = T, typename... Args>
+      requires std::constructible_from<U, Args...>
+      [[nodiscard]] static auto make(Args&&... args) -> InlineBox {
+        InlineBox box;
+
+        if constexpr (fits_inline<U>) {
+          box.obj = std::construct_at(reinterpret_cast<U*>(box.buffer.data()), mem::forward<Args>(args)...);
+          box.vtable = &impl::inline_vtable<U>;
+        } else {
+          U* const value{new U(mem::forward<Args>(args)...)};
+          box.set_heap_ptr(value);
+          box.obj = value;
+          box.vtable = &impl::heap_vtable<U>;
+        }
+
+        return box;
+      }
+
+      /// An InlineBox cannot be copied
+      InlineBox(const InlineBox&) = delete;
+
+      /// Move construction, leaves 'from' in an invalid state, after it is only safe to destroy or reassign.
+      CRAB_INLINE InlineBox(InlineBox&& from) noexcept {
+        take_from(from);
+      }
+
+      /// Conversion of an InlineBox of a derived type into one of its base, the source's capacity must fit in this one
+      /// so that an inline value stays inline.
+      template<std::derived_from<T> Derived, usize OtherCapacity, usize OtherAlign>
+      requires(OtherCapacity <= Capacity and OtherAlign <= Align)
+      CRAB_INLINE InlineBox(InlineBox<Derived, OtherCapacity, OtherAlign>&& from) noexcept {
+        take_from(from);
+      }
+
+      /// Takes ownership of an existing heap allocation, this never moves the value inline.
+      template<impl::boxable_as<T> U>
+      InlineBox(Box<U> from): obj{mem::move(from).into_raw()}, vtable{&impl::heap_vtable<U>} {
+        set_heap_ptr(static_cast<U*>(obj));
+      }
+
+      CRAB_INLINE ~InlineBox() {
+        drop();
+      }
+
+      auto operator=(const InlineBox&) -> void = delete;
+
+      /// Move assignment
+      CRAB_INLINE auto operator=(InlineBox&& rhs) noexcept -> InlineBox& {
+        if (&rhs == this) [[unlikely]] {
+          return *this;
+        }
+
+        drop();
+        take_from(rhs);
+        return *this;
+      }
+
+      /// Move assignment from an InlineBox of a derived type, this will perform the required upcast
+      template<std::derived_from<T> Derived, usize OtherCapacity, usize OtherAlign>
+      requires(OtherCapacity <= Capacity and OtherAlign <= Align)
+      CRAB_INLINE auto operator=(InlineBox<Derived, OtherCapacity, OtherAlign>&& rhs) noexcept -> InlineBox& {
+        drop();
+        take_from(rhs);
+        return *this;
+      }
+
+      /// Implicit conversion from `InlineBox<T>` -> `T&`, alias of as_mut.
+      CRAB_INLINE constexpr operator T&() {
+        return as_mut();
+      }
+
+      /// Implicit conversion from `const InlineBox<T>` -> `const T&`, alias of as_ref.
+      CRAB_INLINE constexpr operator const T&() const {
+        return as_ref();
+      }
+
+      /// Pointer access to contained type
+      [[nodiscard]] CRAB_INLINE constexpr auto operator->() -> T* {
+        return as_ptr_mut();
+      }
+
+      /// Pointer access to contained type
+      [[nodiscard]] CRAB_INLINE constexpr auto operator->() const -> const T* {
+        return as_ptr();
+      }
+
+      /// Dereference of an InlineBox<T> leads to the inner T
+      [[nodiscard]] CRAB_INLINE constexpr auto operator*() -> T& {
+        return as_mut();
+      }
+
+      /// Dereference of an InlineBox<T> leads to the inner T
+      [[nodiscard]] CRAB_INLINE constexpr auto operator*() const -> const T& {
+        return as_ref();
+      }
+
+      /// Gets the inner value as a mutable pointer
+      [[nodiscard]] CRAB_INLINE constexpr auto as_ptr_mut(const SourceLocation loc = SourceLocation::current()) -> T* {
+        crab_dbg_check_with_location(obj != nullptr, loc, "Invalid Use of Moved InlineBox<T>.");
+        return obj;
+      }
+
+      /// Gets the inner value as a pointer
+      [[nodiscard]] CRAB_INLINE constexpr auto as_ptr(const SourceLocation loc = SourceLocation::current()) const
+        -> const T* {
+        crab_dbg_check_with_location(obj != nullptr, loc, "Invalid Use of Moved InlineBox<T>.");
+        return obj;
+      }
+
+      /// Gets the inner value as a mutable reference
+      [[nodiscard]] CRAB_INLINE constexpr auto as_mut(const SourceLocation loc = SourceLocation::current()) -> T& {
+        return *as_ptr_mut(loc);
+      }
+
+      /// Gets the inner value as a reference
+      [[nodiscard]]
+      CRAB_INLINE constexpr auto as_ref(const SourceLocation loc = SourceLocation::current()) const -> const T& {
+        return *as_ptr(loc);
+      }
+
+      /// Whether the value is stored inside of this box, rather than on the heap
+      [[nodiscard]] CRAB_INLINE constexpr auto is_inline(const SourceLocation loc = SourceLocation::current()) const
+        -> bool {
+        crab_dbg_check_with_location(obj != nullptr, loc, "Invalid Use of Moved InlineBox<T>.");
+        return vtable->relocate != nullptr;
+      }
+
+      /// Attempts to downcast the pointer
+      template<std::derived_from<T> Derived>
+      [[nodiscard]] CRAB_INLINE constexpr auto downcast(const SourceLocation loc = SourceLocation::current()) const
+        -> opt::Option<const Derived&> {
+        return ref::from_ptr(ref::dynamic_downcast<const Derived>(as_ptr(loc)));
+      }
+
+      /// Attempts to downcast the pointer
+      template<std::derived_from<T> Derived>
+      [[nodiscard]] CRAB_INLINE constexpr auto downcast(const SourceLocation loc = SourceLocation::current())
+        -> opt::Option<Derived&> {
+        return ref::from_ptr(ref::dynamic_downcast<Derived>(as_ptr_mut(loc)));
+      }
+
+      /// Upcasts to a base type
+      template<typename Base>
+      requires std::derived_from<T, Base>
+      [[nodiscard]] CRAB_INLINE constexpr auto upcast() const -> const Base& {
+        return as_ref();
+      }
+
+      /// Upcasts to a base type
+      template<typename Base>
+      requires std::derived_from<T, Base>
+      [[nodiscard]] CRAB_INLINE constexpr auto upcast() -> Base& {
+        return as_mut();
+      }
+
+    private:
+
+      /// Destroys the value (if any), leaving this value partially formed
+      CRAB_INLINE auto drop() -> void {
+        if (obj != nullptr) {
+          vtable->drop(vtable->relocate != nullptr ? static_cast<void*>(buffer.data()) : heap_ptr());
+          obj = nullptr;
+        }
+      }
+
+      /// Moves the value out of 'from' (which may hold any U derived from T), this must not hold a value already.
+      template<typename U, usize OtherCapacity, usize OtherAlign>
+      CRAB_INLINE auto take_from(InlineBox<U, OtherCapacity, OtherAlign>& from) -> void {
+        vtable = from.vtable;
+
+        if (from.obj == nullptr) {
+          obj = nullptr;
+          return;
+        }
+
+        if (vtable->relocate == nullptr) {
+          set_heap_ptr(from.heap_ptr());
+          obj = mem::take(from.obj);
+          return;
+        }
+
+        // T may be at an offset inside of the complete object (eg. with multiple inheritance)
+        const ptrdiff offset{reinterpret_cast<std::byte*>(from.obj) - from.buffer.data()};
+
+        vtable->relocate(buffer.data(), from.buffer.data());
+        from.obj = nullptr;
+
+        obj = std::launder(reinterpret_cast<U*>(buffer.data() + offset));
+      }
+
+      [[nodiscard]] CRAB_INLINE auto heap_ptr() const -> void* {
+        return *std::launder(reinterpret_cast<void* const*>(buffer.data()));
+      }
+
+      CRAB_INLINE auto set_heap_ptr(void* const ptr) -> void {
+        ::new (static_cast<void*>(buffer.data())) void*{ptr};
+      }
+    };
+
+    /// Specialization for fmt to be able to format an InlineBox<T> if T is formattable.
+    template<typename T, usize Capacity, usize Align>
+    [[nodiscard]] auto format_as(const InlineBox<T, Capacity, Align>& box) -> const T& {
+      return box.as_ref();
+    }
+
+    /// Constructs a Derived (defaulting to T) from the given arguments inside of a new InlineBox<T, Capacity>, see
+    /// InlineBox::make
+    /// @ingroup boxed
+    template<typename T, usize Capacity, impl::boxable_as<T> Derived = T, typename... Args>
+    requires std::constructible_from<Derived, Args...>
+    [[nodiscard]] CRAB_INLINE auto make_inline_box(Args&&... args) -> InlineBox<T, Capacity> {
+      return InlineBox<T, Capacity>::template make<Derived>(mem::forward<Args>(args)...);
+    }
+  }
+
+  /// A valid InlineBox is never null, a moved-from box is null but destroying it does nothing.
+  /// @ingroup boxed
+  template<typename T, usize Capacity, usize Align>
+  struct opt::Niche<boxed::InlineBox<T, Capacity, Align>> :
+      opt::BitNiche<
+        boxed::InlineBox<T, Capacity, Align>,
+        const void*,
+        nullptr,
+        boxed::InlineBox<T, Capacity, Align>::ptr_offset()> {};
+
+  using boxed::make_inline_box;
+
+}
+
+namespace crab::prelude {
+  using boxed::InlineBox;
+}
+
+CRAB_PRELUDE_GUARD;
+
+// NOLINTEND(*explicit*)
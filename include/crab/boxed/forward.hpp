@@ -1,15 +1,22 @@
 #pragma once
 
 #include "crab/core.hpp"
+#include "crab/mem/alloc.hpp"
 #include "crab/ty/classify.hpp"
 
 namespace crab::boxed {
-  template<typename T>
+  template<typename T, typename A = mem::Global>
   class Box;
 
+  template<typename T, usize Capacity, usize Align>
+  class InlineBox;
+
   namespace impl {
-    template<typename T>
+    template<typename T, typename A>
     struct BoxStorage;
+
+    template<typename T, usize Capacity, usize Align>
+    struct InlineBoxStorage;
   }
 
   template<ty::complete_type T, typename... Args>
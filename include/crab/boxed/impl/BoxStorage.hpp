@@ -11,9 +11,9 @@ namespace crab::boxed::impl {
 
   /// Storage container specialization for Option<Box<T>>
   /// @internal
-  template<typename T>
+  template<typename T, typename A>
   struct BoxStorage final {
-    using Box = crab::boxed::Box<T>;
+    using Box = crab::boxed::Box<T, A>;
 
     CRAB_INLINE constexpr explicit BoxStorage(Box value): inner{mem::move(value)} {}
 
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "crab/boxed/forward.hpp"
+#include "crab/core/discard.hpp"
+#include "crab/mem/move.hpp"
+#include "crab/opt/none.hpp"
+#include "crab/assertion/check.hpp"
+
+namespace crab::boxed::impl {
+
+  /// Storage container specialization for Option<InlineBox<T, Capacity, Align>>
+  /// @internal
+  template<typename T, usize Capacity, usize Align>
+  struct InlineBoxStorage final {
+    using InlineBox = crab::boxed::InlineBox<T, Capacity, Align>;
+
+    CRAB_INLINE constexpr explicit InlineBoxStorage(InlineBox value): inner{mem::move(value)} {}
+
+    CRAB_INLINE constexpr explicit InlineBoxStorage(const opt::None& = {}): inner{} {}
+
+    CRAB_INLINE constexpr auto operator=(InlineBox&& value) -> InlineBoxStorage& {
+      crab_check(value.obj != nullptr, "Option<InlineBox<T>>, InlineBoxStorage::operator= called with an invalid box");
+      inner = mem::move(value);
+      return *this;
+    }
+
+    CRAB_INLINE constexpr auto operator=(const opt::None&) -> InlineBoxStorage& {
+      crab::discard(InlineBox{mem::move(inner)});
+      return *this;
+    }
+
+    [[nodiscard]] CRAB_INLINE constexpr auto value() const& -> const InlineBox& {
+      return inner;
+    }
+
+    [[nodiscard]] CRAB_INLINE constexpr auto value() & -> InlineBox& {
+      return inner;
+    }
+
+    [[nodiscard]] CRAB_INLINE constexpr auto value() && -> InlineBox {
+      return mem::move(inner);
+    }
+
+    [[nodiscard]] CRAB_INLINE constexpr auto in_use() const -> bool {
+      return inner.obj != nullptr;
+    }
+
+  private:
+
+    InlineBox inner;
+  };
+}
@@ -150,6 +150,16 @@
 #define CRAB_HAS_ATTRIBUTE(x) 0
 #endif
 
+/// @def CRAB_HAS_BUILTIN(builtin_name)
+/// @hideinitializer
+/// Evaluates to whether or not the given compiler builtin is supported (eg. CRAB_HAS_BUILTIN(__type_pack_element)).
+
+#ifdef __has_builtin
+#define CRAB_HAS_BUILTIN(builtin_name) __has_builtin(builtin_name)
+#else
+#define CRAB_HAS_BUILTIN(x) 0
+#endif
+
 /// @internal
 /// Helper macro for CRAB_PRAGMA
 #define CRAB_PRAGMA_(...) _Pragma(#__VA_ARGS__)
@@ -198,6 +208,27 @@
 #define CRAB_MAY_ALIAS
 #endif
 
+/// @def CRAB_NO_UNIQUE_ADDRESS
+/// @hideinitializer
+/// Annotation for fields that may share their address with another, so that an empty type (eg. a stateless
+/// allocator) takes up no space. MSVC ignores the standard attribute, so its own spelling is used there.
+#if CRAB_MSVC_VERSION && !CRAB_CLANG_VERSION
+#define CRAB_NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#else
+#define CRAB_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#endif
+
+/// @def CRAB_RTTI
+/// @hideinitializer
+/// Defined to be 1 or 0 depending on whether run time type information (typeid / dynamic_cast) is enabled, eg. this is
+/// 0 when compiling with '-fno-rtti'.
+
+#if defined(__GXX_RTTI) || defined(_CPPRTTI) || defined(__cpp_rtti)
+#define CRAB_RTTI 1
+#else
+#define CRAB_RTTI 0
+#endif
+
 /// @def CRAB_CONSTEVAL
 /// @hideinitializer
 /// Alias for 'consteval'. However, this will default to constexpr on compilers that do not support consteval.
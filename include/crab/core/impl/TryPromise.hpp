@@ -0,0 +1,195 @@
+/// @file crab/core/impl/TryPromise.hpp
+/// @internal
+///
+/// Shared machinery for 'try' coroutines, which are functions returning an Option / Result that use co_await to unwrap
+/// another Option / Result, returning early with its None / Err if it has one (see crab/opt/coroutine.hpp and
+/// crab/result/coroutine.hpp).
+///
+/// These coroutines never suspend other than to return early. The value they return (or the exception they throw) is
+/// written into the object returned from the coroutine's ramp (TryReturn), which lives in the caller, rather than into
+/// the frame. The frame is then left to the standard lifetime rules: it is destroyed by flowing off the end of the
+/// coroutine (final_suspend never suspends), or by the awaiter when returning early, so it is always gone by the time
+/// the ramp returns. As the frame's handle never escapes, compilers that implement heap allocation elision (HALO) can
+/// place it on the caller's stack once the ramp is inlined. Frames that are not elided are allocated from a
+/// thread-local pool (TryFramePool), as they are all short lived.
+///
+/// This relies on the return object being converted to the coroutine's return type once the ramp returns, rather
+/// than as soon as it is created. MSVC converts it eagerly, so try coroutines are rejected there at compile time.
+///
+/// GCC before 15 destroys the frame (again) whenever an exception leaves the ramp, even one thrown after the frame was
+/// destroyed by flowing off the end. With those versions exceptions are rethrown from unhandled_exception instead, so
+/// that they leave the ramp while the frame still exists & GCC's own cleanup destroys it exactly once.
+///
+/// These are not free where the frame is not elided: GCC never elides it, & in benchmarks/coroutine.cpp (GCC 12, -O3)
+/// a function using co_await takes roughly 2.5x as long as checking & returning by hand for a Result (~320us against
+/// ~150us), & 20x as long for an Option (~270us against ~13us, where the check by hand is almost free), even with
+/// pooled frames.
+
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+#include "crab/assertion/check.hpp"
+#include "crab/core.hpp"
+#include "crab/mem/forward.hpp"
+#include "crab/mem/impl/BlockPool.hpp"
+#include "crab/mem/move.hpp"
+#include "crab/num/integer.hpp"
+#include "crab/opt/Option.hpp"
+
+#if CRAB_MSVC_VERSION && !CRAB_CLANG_VERSION
+#error "Option / Result coroutines are not supported with MSVC, which converts a coroutine's return object eagerly"
+#endif
+
+namespace crab::impl {
+
+  /// Whether exceptions are let out of unhandled_exception, for the GCC versions that destroy the frame of a coroutine
+  /// when an exception leaves its ramp (see above).
+  /// @internal
+  inline constexpr bool try_rethrows_in_frame{CRAB_GCC_VERSION != 0 and CRAB_GCC_VERSION < 1500};
+
+  /// Pool that the frames of try coroutines are allocated from when they are not elided, frames of up to 512 bytes are
+  /// pooled.
+  /// @internal
+  using TryFramePool = mem::impl::BlockPool<64, 8, 16>;
+
+  template<typename R, typename Promise>
+  class TryPromise;
+
+  /// Object returned from the ramp of a try coroutine returning R, the coroutine writes its result into this, which is
+  /// then converted into that R as the ramp returns.
+  /// @internal
+  template<typename R, typename Promise>
+  class TryReturn final {
+  public:
+
+    CRAB_INLINE explicit TryReturn(TryPromise<R, Promise>& promise): promise{&promise} {
+      promise.slot = this;
+    }
+
+    TryReturn(const TryReturn&) = delete;
+
+    /// Compilers may move the return object before the coroutine's body runs, in which case the promise is pointed
+    /// at the new one.
+    CRAB_INLINE TryReturn(TryReturn&& from) noexcept:
+        value{mem::move(from.value)},
+        exception{mem::move(from.exception)},
+        promise{std::exchange(from.promise, nullptr)} {
+      if (promise != nullptr) {
+        promise->slot = this;
+      }
+    }
+
+    auto operator=(const TryReturn&) -> TryReturn& = delete;
+
+    auto operator=(TryReturn&&) -> TryReturn& = delete;
+
+    CRAB_INLINE ~TryReturn() {
+      if (promise != nullptr) {
+        promise->slot = nullptr;
+      }
+    }
+
+    /// Takes the value the coroutine returned, or rethrows the exception it threw
+    // NOLINTNEXTLINE(*explicit*)
+    [[nodiscard]] CRAB_INLINE operator R() {
+      if (exception) [[unlikely]] {
+        std::rethrow_exception(std::exchange(exception, nullptr));
+      }
+
+      crab_dbg_check(value.is_some(), "A try coroutine was converted to its return type before it returned");
+      return mem::move(value).unwrap();
+    }
+
+  private:
+
+    friend class TryPromise<R, Promise>;
+
+    opt::Option<R> value;
+    std::exception_ptr exception;
+
+    /// Promise of the coroutine while it is running, this is nullptr once its frame is destroyed
+    TryPromise<R, Promise>* promise;
+  };
+
+  /// Promise of a try coroutine returning R, this is the base of the promise for Option / Result (Promise), which says
+  /// what can be co_await'ed.
+  /// @internal
+  template<typename R, typename Promise>
+  class TryPromise {
+  protected:
+
+    TryPromise() = default;
+
+    TryPromise(const TryPromise&) = delete;
+
+    TryPromise(TryPromise&&) = delete;
+
+    auto operator=(const TryPromise&) -> TryPromise& = delete;
+
+    auto operator=(TryPromise&&) -> TryPromise& = delete;
+
+    CRAB_INLINE ~TryPromise() {
+      if (slot != nullptr) {
+        slot->promise = nullptr;
+      }
+    }
+
+  public:
+
+    /// Allocates the coroutine's frame, this is only called if the frame was not elided
+    [[nodiscard]] CRAB_INLINE static auto operator new(const usize size) -> void* {
+      return TryFramePool::allocate(size);
+    }
+
+    CRAB_INLINE static auto operator delete(void* const raw, const usize size) -> void {
+      TryFramePool::deallocate(raw, size);
+    }
+
+    [[nodiscard]] CRAB_INLINE auto get_return_object() -> TryReturn<R, Promise> {
+      return TryReturn<R, Promise>{*this};
+    }
+
+    /// The body runs as soon as the coroutine is called
+    [[nodiscard]] CRAB_INLINE static auto initial_suspend() noexcept -> std::suspend_never {
+      return {};
+    }
+
+    /// The frame is destroyed as soon as the body finishes, the result has already been written to the TryReturn
+    [[nodiscard]] CRAB_INLINE static auto final_suspend() noexcept -> std::suspend_never {
+      return {};
+    }
+
+    template<typename V>
+    requires std::constructible_from<R, V>
+    CRAB_INLINE auto return_value(V&& value) -> void {
+      slot->value = R(mem::forward<V>(value));
+    }
+
+    /// Exceptions are caught & rethrown by TryReturn once the ramp returns, so that the frame is destroyed by flowing
+    /// off the end of the coroutine like any other (except with GCC before 15, see try_rethrows_in_frame)
+    CRAB_INLINE auto unhandled_exception() -> void {
+      if constexpr (try_rethrows_in_frame) {
+        throw;
+      } else {
+        slot->exception = std::current_exception();
+      }
+    }
+
+    /// Returns early with the given value & destroys the frame, this is called from await_suspend (with the handle of
+    /// this coroutine), after which this promise is no longer valid.
+    CRAB_INLINE auto return_early(const std::coroutine_handle<Promise> handle, R&& value) -> void {
+      slot->value = mem::move(value);
+      handle.destroy();
+    }
+
+  private:
+
+    friend class TryReturn<R, Promise>;
+
+    /// Where the coroutine's result is written to
+    TryReturn<R, Promise>* slot{nullptr};
+  };
+}
@@ -35,13 +35,13 @@ namespace crab::fn {
 
     template<typename T>
     [[nodiscard]] CRAB_INLINE constexpr auto operator()(rc::RcMut<T> value) const {
-      return value.template downcast<T>();
+      return value.template downcast<Derived>();
     }
 
     template<typename T>
     [[nodiscard]]
     inline constexpr auto operator()(Rc<T> value) const -> opt::Option<Rc<Derived>> {
-      return value.template downcast<T>();
+      return value.template downcast<Derived>();
     }
 
     template<typename T>
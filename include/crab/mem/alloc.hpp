@@ -0,0 +1,186 @@
+/// @file crab/mem/alloc.hpp
+
+#pragma once
+
+#include <concepts>
+#include <memory>
+#include <type_traits>
+
+#include "crab/core.hpp"
+#include "crab/mem/forward.hpp"
+#include "crab/mem/move.hpp"
+#include "crab/num/integer.hpp"
+
+namespace crab::mem {
+  /// @addtogroup mem
+  /// @{
+
+  /// The global allocator, objects are allocated with 'new' and freed with 'delete' (or new[] / delete[] for arrays).
+  /// This is the default allocator for Box<T> and make_rc.
+  ///
+  /// Unlike a standard allocator, a pointer to a derived type may be freed through a pointer to its base (as long as
+  /// the base has a virtual destructor), which is what allows Box<Derived> to convert into Box<Base>.
+  struct Global final {
+    [[nodiscard]] CRAB_INLINE constexpr auto operator==(const Global&) const -> bool {
+      return true;
+    }
+  };
+
+  /// Allocator that can be given to Box<T, A>, make_box_in and make_rc_in. This is either mem::Global or any type
+  /// meeting the standard Allocator requirements (eg. std::allocator<T> or std::pmr::polymorphic_allocator<T>), which
+  /// is rebound to whatever type is being allocated.
+  template<typename A>
+  concept allocator = std::same_as<A, Global> or requires(A& alloc, typename A::value_type* ptr, const usize length) {
+    typename A::value_type;
+    { alloc.allocate(length) } -> std::same_as<typename A::value_type*>;
+    alloc.deallocate(ptr, length);
+    requires std::copy_constructible<A>;
+  };
+
+  /// Allocator with no state, these take up no space inside of a Box<T, A> or a control block.
+  template<typename A>
+  concept stateless_allocator = allocator<A> and std::is_empty_v<A>;
+
+  namespace impl {
+    template<typename T, allocator A>
+    using rebound = typename std::allocator_traits<A>::template rebind_alloc<T>;
+
+    /// Gives back an allocation if it was never released, so that a throwing constructor does not leak.
+    template<typename Alloc>
+    struct AllocationGuard final {
+      using Traits = std::allocator_traits<Alloc>;
+      using T = typename Traits::value_type;
+
+      Alloc& alloc;
+      T* ptr;
+      usize length;
+
+      CRAB_INLINE constexpr AllocationGuard(Alloc& alloc, const usize length):
+          alloc{alloc}, ptr{Traits::allocate(alloc, length)}, length{length} {}
+
+      AllocationGuard(const AllocationGuard&) = delete;
+
+      auto operator=(const AllocationGuard&) -> AllocationGuard& = delete;
+
+      CRAB_INLINE constexpr ~AllocationGuard() {
+        if (ptr != nullptr) {
+          Traits::deallocate(alloc, ptr, length);
+        }
+      }
+
+      [[nodiscard]] CRAB_INLINE constexpr auto release() -> T* {
+        T* const released{ptr};
+        ptr = nullptr;
+        return released;
+      }
+    };
+  }
+
+  /// Allocates and constructs a single T with the given allocator, the equivalent of 'new T(args...)'.
+  template<typename T, allocator A, typename... Args>
+  requires std::constructible_from<T, Args...>
+  [[nodiscard]] CRAB_INLINE constexpr auto alloc_new(A& alloc, Args&&... args) -> T* {
+    if constexpr (std::same_as<A, Global>) {
+      return new T(mem::forward<Args>(args)...);
+    } else {
+      using Alloc = impl::rebound<T, A>;
+      using Traits = std::allocator_traits<Alloc>;
+
+      Alloc rebound{alloc};
+      impl::AllocationGuard<Alloc> guard{rebound, 1};
+      Traits::construct(rebound, guard.ptr, mem::forward<Args>(args)...);
+      return guard.release();
+    }
+  }
+
+  /// Destroys and frees a T that was made by alloc_new with an equal allocator, the equivalent of 'delete ptr'.
+  template<typename T, allocator A>
+  CRAB_INLINE constexpr auto alloc_delete(A& alloc, T* const ptr) -> void {
+    if constexpr (std::same_as<A, Global>) {
+      delete ptr;
+    } else {
+      if (ptr == nullptr) {
+        return;
+      }
+
+      using Alloc = impl::rebound<T, A>;
+      using Traits = std::allocator_traits<Alloc>;
+
+      Alloc rebound{alloc};
+      Traits::destroy(rebound, ptr);
+      Traits::deallocate(rebound, ptr, 1);
+    }
+  }
+
+  /// Allocates an array of 'length' value-initialized T with the given allocator, the equivalent of 'new T[length]()'.
+  template<typename T, allocator A>
+  requires std::default_initializable<T>
+  [[nodiscard]] CRAB_INLINE constexpr auto alloc_new_array(A& alloc, const usize length) -> T* {
+    if constexpr (std::same_as<A, Global>) {
+      return new T[length]();
+    } else {
+      using Alloc = impl::rebound<T, A>;
+      using Traits = std::allocator_traits<Alloc>;
+
+      Alloc rebound{alloc};
+      impl::AllocationGuard<Alloc> guard{rebound, length};
+
+      usize constructed{0};
+
+      // destroys whatever was constructed if a later element throws
+      struct Unwind final {
+        Alloc& alloc;
+        T* elements;
+        usize& count;
+
+        CRAB_INLINE constexpr ~Unwind() {
+          while (count != 0) {
+            Traits::destroy(alloc, elements + --count);
+          }
+        }
+      } unwind{rebound, guard.ptr, constructed};
+
+      for (; constructed < length; constructed++) {
+        Traits::construct(rebound, guard.ptr + constructed);
+      }
+
+      constructed = 0;
+      return guard.release();
+    }
+  }
+
+  /// Destroys and frees an array made by alloc_new_array with an equal allocator, the equivalent of 'delete[] ptr'.
+  template<typename T, allocator A>
+  CRAB_INLINE constexpr auto alloc_delete_array(A& alloc, T* const ptr, const usize length) -> void {
+    if constexpr (std::same_as<A, Global>) {
+      delete[] ptr;
+    } else {
+      if (ptr == nullptr) {
+        return;
+      }
+
+      using Alloc = impl::rebound<T, A>;
+      using Traits = std::allocator_traits<Alloc>;
+
+      Alloc rebound{alloc};
+      for (usize i = length; i != 0; i--) {
+        Traits::destroy(rebound, ptr + i - 1);
+      }
+      Traits::deallocate(rebound, ptr, length);
+    }
+  }
+
+  /// Moves an allocator into another, for allocators that cannot be assigned (eg. std::pmr::polymorphic_allocator) the
+  /// old one is destroyed and the new one is constructed in its place.
+  template<allocator A>
+  CRAB_INLINE constexpr auto replace_allocator(A& into, A&& from) -> void {
+    if constexpr (std::is_move_assignable_v<A>) {
+      into = mem::move(from);
+    } else {
+      std::destroy_at(std::addressof(into));
+      std::construct_at(std::addressof(into), mem::move(from));
+    }
+  }
+
+  /// @}
+}
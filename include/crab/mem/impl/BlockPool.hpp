@@ -0,0 +1,150 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <new>
+
+#include "crab/core.hpp"
+#include "crab/num/integer.hpp"
+
+namespace crab::mem::impl {
+
+  /**
+   * Thread-local pool for small blocks that are allocated & freed often, eg. the counters of Rc / RcMut (see
+   * rc::impl::CounterPool) or the frames of try coroutines.
+   *
+   * Blocks are grouped into 'ClassCount' size classes of 'Granularity' bytes, each with its own free list. Every block
+   * is still an individual allocation from the global operator new (so is aligned to __STDCPP_DEFAULT_NEW_ALIGNMENT__),
+   * the pool only keeps freed blocks around for reuse (up to 'MaxCached' per class), so a block may be freed on a
+   * different thread than the one that allocated it. Anything cached is given back to the global allocator when the
+   * thread exits.
+   *
+   * Each instantiation has its own pool per thread.
+   */
+  template<usize Granularity, usize ClassCount, usize MaxCached>
+  class BlockPool final {
+  public:
+
+    /// Largest block size that is pooled, anything bigger goes straight to the global allocator.
+    static constexpr usize MaxSize{Granularity * ClassCount};
+
+    /**
+     * Allocates a block of at least 'size' bytes.
+     */
+    [[nodiscard]] static CRAB_INLINE auto allocate(const usize size) -> void* {
+      if (size <= MaxSize) [[likely]] {
+        if (Cache* const cache{current_or_create()}) [[likely]] {
+          if (FreeBlock* const block{cache->lists[class_of(size)].pop()}) [[likely]] {
+            return block;
+          }
+        }
+
+        return ::operator new(rounded(size));
+      }
+
+      return ::operator new(size);
+    }
+
+    /**
+     * Frees a block given by BlockPool::allocate, 'size' must be the same as was requested.
+     */
+    static CRAB_INLINE auto deallocate(void* const raw, const usize size) -> void {
+      if (size <= MaxSize) [[likely]] {
+        if (Cache* const cache{current_or_create()}) [[likely]] {
+          if (cache->lists[class_of(size)].push(raw)) [[likely]] {
+            return;
+          }
+        }
+      }
+
+      ::operator delete(raw);
+    }
+
+  private:
+
+    struct FreeBlock final {
+      FreeBlock* next;
+    };
+
+    struct FreeList final {
+      FreeBlock* head{nullptr};
+      usize length{0};
+
+      [[nodiscard]] CRAB_INLINE auto pop() -> FreeBlock* {
+        FreeBlock* const block{head};
+
+        if (block != nullptr) {
+          head = block->next;
+          length--;
+        }
+
+        return block;
+      }
+
+      /// Returns false if the list is full, in which case the block is left alone.
+      [[nodiscard]] CRAB_INLINE auto push(void* const raw) -> bool {
+        if (length == MaxCached) [[unlikely]] {
+          return false;
+        }
+
+        head = ::new (raw) FreeBlock{head};
+        length++;
+        return true;
+      }
+    };
+
+    struct Cache final {
+      std::array<FreeList, ClassCount> lists{};
+    };
+
+    /// Owns the calling thread's cache, and frees everything in it as the thread exits.
+    struct ThreadHandle;
+
+    [[nodiscard]] static CRAB_INLINE constexpr auto class_of(const usize size) -> usize {
+      return size == 0 ? 0 : (size - 1) / Granularity;
+    }
+
+    [[nodiscard]] static CRAB_INLINE constexpr auto rounded(const usize size) -> usize {
+      return (class_of(size) + 1) * Granularity;
+    }
+
+    /// Cache for the calling thread, this is nullptr once the thread has started exiting.
+    [[nodiscard]] static auto current_or_create() -> Cache*;
+
+    static inline thread_local Cache* current{nullptr};
+    static inline thread_local bool exited{false};
+  };
+
+  template<usize Granularity, usize ClassCount, usize MaxCached>
+  struct BlockPool<Granularity, ClassCount, MaxCached>::ThreadHandle final {
+    Cache cache;
+
+    ThreadHandle() = default;
+
+    ThreadHandle(const ThreadHandle&) = delete;
+
+    auto operator=(const ThreadHandle&) -> ThreadHandle& = delete;
+
+    ~ThreadHandle() {
+      // blocks freed from here on (eg. by later thread_local destructors) go straight to the global allocator
+      current = nullptr;
+      exited = true;
+
+      for (FreeList& list: cache.lists) {
+        while (FreeBlock* const block{list.pop()}) {
+          ::operator delete(block);
+        }
+      }
+    }
+  };
+
+  template<usize Granularity, usize ClassCount, usize MaxCached>
+  inline auto BlockPool<Granularity, ClassCount, MaxCached>::current_or_create() -> Cache* {
+    if (current == nullptr and not exited) [[unlikely]] {
+      static thread_local ThreadHandle handle;
+      current = &handle.cache;
+    }
+
+    return current;
+  }
+}
@@ -17,6 +17,7 @@
 
 #include "crab/opt/impl/GenericStorage.hpp"
 #include "crab/opt/impl/RefStorage.hpp"
+#include "crab/opt/niche.hpp"
 
 #include "crab/hash/hash.hpp"
 #include "crab/opt/concepts.hpp"
@@ -53,11 +54,19 @@ namespace crab::opt {
     using type = impl::RefStorage<T&>;
   };
 
+  /// Niche for an Option<T> that keeps a separate in use flag, which has the same unused values as a bool. This is what
+  /// lets Option<Option<T>> be the same size as Option<T>.
+  /// @ingroup opt
+  template<typename T>
+  requires std::same_as<typename Storage<T>::type, impl::GenericStorage<T>> and (not has_niche<T>)
+  struct Niche<Option<T>> : BitNiche<Option<T>, u8, 0xFF, impl::GenericStorage<T>::FlagOffset> {};
+
   /// Tagged union type between T and unit, alternative to std::optional<T>. For more details, read topic
   /// [Option](#opt).
   ///
   /// Note that unlike most types in crab, a moved-from option is valid to be used - as it is guarenteed that an option
-  /// that is moved results in an empty option.
+  /// that is moved results in an empty option. The exception is when T is trivially copyable (or a reference), as then
+  /// Option<T> is too and moving it is a plain copy.
   ///
   /// @ingroup opt
   /// @ingroup prelude
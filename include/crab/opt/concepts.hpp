@@ -75,7 +75,7 @@ namespace crab::opt {
     requires std::constructible_from<Storage, None>;
 
     // supports moving around at the bare minimum
-    requires ty::movable<Storage>;
+    requires ty::movable_object<Storage>;
 
     // can assign to be a value
     requires std::is_assignable_v<Storage, T&&>;
@@ -0,0 +1,78 @@
+/// @file crab/opt/coroutine.hpp
+/// @ingroup opt
+///
+/// Lets a function returning an Option be written as a coroutine, in which co_await'ing another Option unwraps it, or
+/// returns early with None.
+///
+/// ```cpp
+/// auto find_email(const Users& users, StringView name) -> Option<String> {
+///   const User& user{co_await users.find(name)};
+///   const Profile& profile{co_await user.profile()};
+///
+///   co_return profile.email;
+/// }
+/// ```
+///
+/// This is the same as checking is_none & returning None after every call, but not as cheap: the coroutine's frame is
+/// allocated (from a pool) unless the compiler elides it, which GCC never does, making a co_await many times slower
+/// than the check it replaces (see crab/core/impl/TryPromise.hpp). Prefer checking by hand on hot paths.
+
+#pragma once
+
+#include <coroutine>
+
+#include "crab/core.hpp"
+#include "crab/core/impl/TryPromise.hpp"
+#include "crab/core/unsafe.hpp"
+#include "crab/mem/move.hpp"
+#include "crab/opt/Option.hpp"
+
+namespace crab::opt::impl {
+
+  /// Awaiter for an Option co_await'ed in a coroutine returning Option<T>
+  /// @internal
+  template<typename T, typename U>
+  class OptionAwaiter final {
+  public:
+
+    CRAB_INLINE explicit OptionAwaiter(Option<U>& option): option{option} {}
+
+    [[nodiscard]] CRAB_INLINE auto await_ready() const -> bool {
+      return option.is_some();
+    }
+
+    /// Returns early from the coroutine with None
+    template<typename Promise>
+    CRAB_INLINE auto await_suspend(const std::coroutine_handle<Promise> handle) -> void {
+      handle.promise().return_early(handle, Option<T>{});
+    }
+
+    [[nodiscard]] CRAB_INLINE auto await_resume() -> U {
+      return mem::move(option).unwrap_unchecked(unsafe);
+    }
+
+  private:
+
+    Option<U>& option;
+  };
+
+  /// Promise type for a coroutine returning Option<T>
+  /// @internal
+  template<typename T>
+  class OptionPromise final : public crab::impl::TryPromise<Option<T>, OptionPromise<T>> {
+  public:
+
+    /// Unwraps the given option, or returns early with None
+    template<typename U>
+    [[nodiscard]] CRAB_INLINE auto await_transform(Option<U>&& option) -> OptionAwaiter<T, U> {
+      return OptionAwaiter<T, U>{option};
+    }
+  };
+}
+
+/// Makes any function returning an Option able to be a coroutine
+/// @relates crab::opt::Option
+template<typename T, typename... Args>
+struct std::coroutine_traits<crab::opt::Option<T>, Args...> {
+  using promise_type = crab::opt::impl::OptionPromise<T>;
+};
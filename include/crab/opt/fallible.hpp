@@ -1,5 +1,6 @@
 #pragma once
 
+#include <tuple>
 #include "crab/core.hpp"
 #include "crab/opt/Option.hpp"
 #include "crab/opt/concepts.hpp"
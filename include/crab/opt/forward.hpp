@@ -11,4 +11,7 @@ namespace crab::opt {
 
   template<typename T>
   struct Storage;
+
+  template<typename T>
+  struct Niche;
 }
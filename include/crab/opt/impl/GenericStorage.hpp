@@ -3,17 +3,20 @@
 
 #pragma once
 
+#include "crab/assertion/check.hpp"
 #include "crab/core.hpp"
 #include "crab/mem/move.hpp"
 #include "crab/mem/address_of.hpp"
 #include "crab/mem/forward.hpp"
 #include "crab/mem/size_of.hpp"
+#include "crab/opt/niche.hpp"
 #include "crab/opt/none.hpp"
 #include "crab/str/str.hpp"
 #include "crab/ty/construct.hpp"
 
 #include <array>
 #include <concepts>
+#include <type_traits>
 #include <vector>
 
 #if CRAB_GCC_VERSION
@@ -22,41 +25,124 @@
 #endif
 
 namespace crab::opt::impl {
-  /// Generic tagged union storage for Option<T>
+  /// Whether a GenericStorage holds a value, kept as a separate flag after the value.
+  /// @internal
+  /// @ingroup opt
+  template<typename T>
+  struct InUseFlag {
+    [[nodiscard]] CRAB_INLINE constexpr auto get(const std::byte*) const -> bool {
+      return flag;
+    }
+
+    CRAB_INLINE constexpr auto set(std::byte*, const bool in_use) -> void {
+      flag = in_use;
+    }
+
+    bool flag;
+  };
+
+  /// Whether a GenericStorage holds a value, kept inside of the value's own storage using the niche of T (see Niche).
+  /// Note that this must be set to false only after the value is destroyed.
+  /// @internal
+  /// @ingroup opt
+  template<has_niche T>
+  struct InUseFlag<T> {
+    [[nodiscard]] CRAB_INLINE constexpr auto get(const std::byte* const storage) const -> bool {
+      return not Niche<T>::is_none(storage);
+    }
+
+    CRAB_INLINE constexpr auto set(std::byte* const storage, const bool in_use) -> void {
+      if (not in_use) {
+        Niche<T>::set_none(storage);
+        return;
+      }
+
+      crab_dbg_check(
+        not Niche<T>::is_none(storage),
+        "Cannot store a value in an Option that has the same bit pattern as the niche of its type"
+      );
+    }
+  };
+
+  /// Whether copy constructing a GenericStorage<T> can be a plain copy of its bytes
+  /// @internal
+  template<typename T>
+  concept trivial_copy = ty::copy_constructible<T> and std::is_trivially_copy_constructible_v<T>;
+
+  /// Whether move constructing a GenericStorage<T> can be a plain copy of its bytes
+  /// @internal
+  template<typename T>
+  concept trivial_move = std::is_trivially_move_constructible_v<T>;
+
+  /// Whether copy assigning a GenericStorage<T> can be a plain copy of its bytes, this is only the case if every way
+  /// that assignment could go (assign, construct or destroy) is trivial.
+  /// @internal
+  template<typename T>
+  concept trivial_copy_assign = trivial_copy<T> and std::is_trivially_copy_assignable_v<T>
+                            and std::is_trivially_destructible_v<T>;
+
+  /// Whether move assigning a GenericStorage<T> can be a plain copy of its bytes
+  /// @internal
+  template<typename T>
+  concept trivial_move_assign = trivial_move<T> and std::is_trivially_move_assignable_v<T>
+                            and std::is_trivially_destructible_v<T>;
+
+  /// Generic tagged union storage for Option<T>, this only needs a separate flag when T has no niche.
+  ///
+  /// Copying, moving & destroying the storage is trivial whenever it is for T, so that an Option of a trivially
+  /// copyable type is itself trivially copyable (eg. it can be passed in registers, or memcpy'd by containers). Note
+  /// that this means moving from such an option is a copy, which leaves the original as it was.
   /// @internal
   /// @ingroup opt
   template<typename T>
   struct GenericStorage {
 
     /// Initialise to Some(value)
-    CRAB_INLINE constexpr explicit GenericStorage(T&& value): in_use_flag{true} {
+    CRAB_INLINE constexpr explicit GenericStorage(T&& value) {
       std::construct_at<T, T&&>(address(), mem::forward<T>(value));
+      set_in_use(true);
     }
 
     /// Copy initialise to Some(value)
     CRAB_INLINE constexpr explicit GenericStorage(const T& value) requires ty::copy_constructible<T>
-        : in_use_flag(true) {
+    {
       std::construct_at<T, const T&>(address(), value);
+      set_in_use(true);
     }
 
     /// Default initialise to none
-    CRAB_INLINE constexpr explicit GenericStorage(const None& = {}): in_use_flag{false} {}
+    CRAB_INLINE constexpr explicit GenericStorage(const None& = {}) {
+      set_in_use(false);
+    }
+
+    constexpr GenericStorage(const GenericStorage&) requires trivial_copy<T>
+    = default;
 
     constexpr GenericStorage(const GenericStorage& from) requires ty::copy_constructible<T>
-        : in_use_flag{from.in_use_flag} {
-      if (in_use()) {
+    {
+      if (from.in_use()) {
         std::construct_at<T, const T&>(address(), from.value());
       }
+      set_in_use(from.in_use());
     }
 
-    constexpr GenericStorage(GenericStorage&& from) noexcept: in_use_flag{from.in_use_flag} {
-      if (in_use()) {
+    constexpr GenericStorage(GenericStorage&&) noexcept requires trivial_move<T>
+    = default;
+
+    constexpr GenericStorage(GenericStorage&& from) noexcept {
+      if (from.in_use()) {
         std::construct_at<T, T&&>(address(), mem::move(from.value()));
         std::destroy_at(from.address());
-        from.in_use_flag = false;
+        from.set_in_use(false);
+        set_in_use(true);
+      } else {
+        set_in_use(false);
       }
     }
 
+    constexpr GenericStorage& operator=(const GenericStorage&) requires trivial_copy_assign<T>
+    = default;
+
     constexpr GenericStorage& operator=(const GenericStorage& from) {
       if (crab::mem::address_of(from) == this) {
         return *this;
@@ -72,40 +158,44 @@ namespace crab::opt::impl {
       return *this;
     }
 
+    constexpr GenericStorage& operator=(GenericStorage&&) noexcept requires trivial_move_assign<T>
+    = default;
+
     constexpr GenericStorage& operator=(GenericStorage&& from) noexcept(std::is_nothrow_move_assignable_v<T>) {
       if (not from.in_use()) {
         operator=(None{});
         return *this;
       }
 
-      if (in_use_flag) {
+      if (in_use()) {
         *address() = mem::move(from.value());
       } else {
         std::construct_at<T, T&&>(address(), mem::move(from.value()));
-        in_use_flag = true;
+        set_in_use(true);
       }
 
       std::destroy_at(from.address());
-      from.in_use_flag = false;
+      from.set_in_use(false);
 
       return *this;
     }
 
-    constexpr ~GenericStorage() {
+    constexpr ~GenericStorage() requires std::is_trivially_destructible_v<T>
+    = default;
 
-      if (in_use_flag) {
+    constexpr ~GenericStorage() {
+      if (in_use()) {
         std::destroy_at(address());
-        in_use_flag = false;
       }
     }
 
     /// Move reassign to Some(value)
     constexpr auto operator=(T&& value) noexcept(std::is_nothrow_move_assignable_v<T>) -> GenericStorage& {
-      if (in_use_flag) {
+      if (in_use()) {
         *address() = mem::forward<T>(value);
       } else {
         std::construct_at<T, T&&>(address(), mem::forward<T>(value));
-        in_use_flag = true;
+        set_in_use(true);
       }
       return *this;
     }
@@ -113,11 +203,11 @@ namespace crab::opt::impl {
     /// Copy reassign to Some(value)
     constexpr auto operator=(const T& from) -> GenericStorage& requires ty::copy_assignable<T>
     {
-      if (in_use_flag) {
+      if (in_use()) {
         value() = from;
       } else {
         std::construct_at<T, const T&>(address(), from);
-        in_use_flag = true;
+        set_in_use(true);
       }
       return *this;
     }
@@ -125,9 +215,9 @@ namespace crab::opt::impl {
     /// Reassign to None
     constexpr auto operator=(const None&) -> GenericStorage& {
 
-      if (in_use_flag) {
+      if (in_use()) {
         std::destroy_at(address());
-        in_use_flag = false;
+        set_in_use(false);
       }
 
       return *this;
@@ -145,16 +235,25 @@ namespace crab::opt::impl {
       T moved{mem::move(reinterpret_cast<T&>(bytes))};
 
       std::destroy_at<T>(address());
-      in_use_flag = false;
+      set_in_use(false);
       return moved;
     }
 
     [[nodiscard]] CRAB_INLINE constexpr auto in_use() const -> bool {
-      return in_use_flag;
+      return in_use_flag.get(bytes.data());
     }
 
+    /// Offset of the separate in use flag, for storages that have one
+    /// @internal
+    static constexpr usize FlagOffset{mem::size_of<T>()};
+
   private:
 
+    /// Marks whether this holds a value, this must be called after the value is constructed / destroyed.
+    CRAB_INLINE constexpr auto set_in_use(const bool in_use) -> void {
+      in_use_flag.set(bytes.data(), in_use);
+    }
+
     [[nodiscard]] CRAB_INLINE CRAB_RETURNS_NONNULL constexpr auto address() -> T* {
       return reinterpret_cast<T*>(bytes.data());
     }
@@ -164,7 +263,7 @@ namespace crab::opt::impl {
     }
 
     alignas(T) std::array<std::byte, mem::size_of<T>()> bytes;
-    bool in_use_flag;
+    CRAB_NO_UNIQUE_ADDRESS InUseFlag<T> in_use_flag;
   };
 }
 
@@ -10,7 +10,8 @@
 #include "crab/ty/manipulate.hpp"
 
 namespace crab::opt::impl {
-  /// Specialized storage for Option<T&> to not require an in_use flag
+  /// Specialized storage for Option<T&> to not require an in_use flag, this is trivially copyable (so moving from an
+  /// Option<T&> leaves it as it was).
   /// @ingroup opt
   /// @internal
   template<typename R>
@@ -23,9 +24,7 @@ namespace crab::opt::impl {
 
     CRAB_INLINE constexpr RefStorage(const RefStorage& from) = default;
 
-    CRAB_INLINE constexpr RefStorage(RefStorage&& from) noexcept {
-      inner = mem::take(from.inner);
-    }
+    CRAB_INLINE constexpr RefStorage(RefStorage&& from) noexcept = default;
 
     CRAB_INLINE constexpr RefStorage& operator=(const RefStorage& from) = default;
 
@@ -3,6 +3,7 @@
 /// @internal
 #pragma once
 
+#include <tuple>
 #include "crab/opt/Option.hpp"
 #include "crab/mem/forward.hpp"
 
@@ -0,0 +1,142 @@
+/// @file crab/opt/niche.hpp
+/// @ingroup opt
+/// Niche trait for letting Option<T> represent None with an unused bit pattern of T, rather than a separate flag.
+
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "crab/core.hpp"
+#include "crab/num/integer.hpp"
+#include "crab/opt/forward.hpp"
+#include "crab/ref/forward.hpp"
+
+namespace crab::opt {
+
+  /// Niche trait for T, a specialization declares a bit pattern that no valid T ever has, so that Option<T> can use it
+  /// to represent None and be the same size as T.
+  ///
+  /// By default types have no niche. A specialization must provide the following, where 'storage' is the (suitably
+  /// sized & aligned) storage that the option would hold a T in:
+  ///
+  /// ```cpp
+  /// // writes the sentinel pattern into storage that does not hold a T
+  /// static auto set_none(std::byte* storage) -> void;
+  ///
+  /// // whether the given storage holds the sentinel pattern, rather than a T
+  /// static auto is_none(const std::byte* storage) -> bool;
+  /// ```
+  ///
+  /// Most types can use ValueNiche or BitNiche instead of writing these by hand. A niche may also say which bytes of T
+  /// it lies in (BitNiche does), which lets Result<T, E> store a small E in the rest of T's bytes:
+  ///
+  /// ```cpp
+  /// static constexpr usize NicheOffset; // first byte of the sentinel pattern
+  /// static constexpr usize NicheSize;   // number of bytes in the sentinel pattern
+  /// ```
+  ///
+  /// If a moved-from T has the sentinel pattern (like a null Box), destroying it must do nothing, as it is no longer
+  /// considered to hold a T.
+  ///
+  /// # Examples
+  /// ```cpp
+  /// enum class Direction : u8 { North, East, South, West };
+  ///
+  /// template<>
+  /// struct crab::opt::Niche<Direction> : crab::opt::ValueNiche<Direction, Direction{0xFF}> {};
+  ///
+  /// static_assert(sizeof(Option<Direction>) == sizeof(Direction));
+  /// ```
+  ///
+  /// @ingroup opt
+  template<typename T>
+  struct Niche {};
+
+  /// Whether T has a niche that Option<T> can use to represent None
+  /// @ingroup opt
+  template<typename T>
+  concept has_niche = requires(std::byte* storage, const std::byte* const_storage) {
+    { Niche<T>::set_none(storage) } -> std::same_as<void>;
+    { Niche<T>::is_none(const_storage) } -> std::same_as<bool>;
+  };
+
+  /// Whether T has a niche that also says which of T's bytes it lies in, so the rest may hold another value while T is
+  /// not stored
+  /// @ingroup opt
+  template<typename T>
+  concept has_placed_niche = has_niche<T> and requires {
+    { Niche<T>::NicheOffset } -> std::convertible_to<usize>;
+    { Niche<T>::NicheSize } -> std::convertible_to<usize>;
+  };
+
+  /// Niche made from the bit pattern 'Pattern' of type Repr, found 'Offset' bytes into T.
+  /// @ingroup opt
+  template<typename T, typename Repr, Repr Pattern, usize Offset = 0>
+  struct BitNiche {
+    static_assert(std::is_trivially_copyable_v<Repr>, "The representation of a niche must be trivially copyable");
+    static_assert(Offset + sizeof(Repr) <= sizeof(T), "A niche must lie within the type it is for");
+
+    /// First byte of T that the niche lies in
+    static constexpr usize NicheOffset{Offset};
+
+    /// Number of bytes of T that the niche lies in
+    static constexpr usize NicheSize{sizeof(Repr)};
+
+    CRAB_INLINE static auto set_none(std::byte* const storage) -> void {
+      constexpr Repr pattern{Pattern};
+      std::memcpy(storage + Offset, &pattern, sizeof(Repr));
+    }
+
+    [[nodiscard]] CRAB_INLINE static auto is_none(const std::byte* const storage) -> bool {
+      Repr repr;
+      std::memcpy(&repr, storage + Offset, sizeof(Repr));
+      return repr == Pattern;
+    }
+  };
+
+  /// Niche for a value of T that is never used (eg. an out of range value of an enum), note that T must be usable as a
+  /// template parameter & comparable by bits.
+  /// @ingroup opt
+  template<typename T, T Sentinel>
+  requires std::has_unique_object_representations_v<T>
+  struct ValueNiche : BitNiche<T, T, Sentinel> {};
+
+  /// Any byte other than 0 or 1 is not a valid bool
+  /// @ingroup opt
+  template<>
+  struct Niche<bool> : BitNiche<bool, u8, 0xFF> {};
+
+  /// A floating point value uses a NaN with a payload that is not produced by arithmetic, nor by
+  /// std::numeric_limits<float>::quiet_NaN / signaling_NaN. Storing a value with this exact bit pattern in an Option is
+  /// caught in debug builds.
+  /// @ingroup opt
+  template<>
+  struct Niche<float> : BitNiche<float, u32, 0x7FA0'C0DEu> {
+    static_assert(std::numeric_limits<float>::is_iec559 and sizeof(float) == sizeof(u32));
+  };
+
+  /// @copydoc Niche<float>
+  /// @ingroup opt
+  template<>
+  struct Niche<double> : BitNiche<double, u64, 0x7FF4'C0DE'C0DE'C0DEull> {
+    static_assert(std::numeric_limits<double>::is_iec559 and sizeof(double) == sizeof(u64));
+  };
+
+  /// A Ref<T> is never null
+  /// @ingroup opt
+  template<typename T>
+  struct Niche<ref::Ref<T>> : BitNiche<ref::Ref<T>, const T*, nullptr> {
+    static_assert(sizeof(ref::Ref<T>) == sizeof(const T*));
+  };
+
+  /// A RefMut<T> is never null
+  /// @ingroup opt
+  template<typename T>
+  struct Niche<ref::RefMut<T>> : BitNiche<ref::RefMut<T>, T*, nullptr> {
+    static_assert(sizeof(ref::RefMut<T>) == sizeof(T*));
+  };
+}
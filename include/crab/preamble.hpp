@@ -25,6 +25,7 @@
 #include "crab/num/range.hpp"
 #include "crab/num/suffixes.hpp"
 
+#include "crab/str/StaticStr.hpp"
 #include "crab/str/str.hpp"
 
 #include "crab/ty/bool_types.hpp"
@@ -45,6 +46,7 @@
 #include "crab/assertion/todo.hpp"
 
 #include "crab/mem/address_of.hpp"
+#include "crab/mem/alloc.hpp"
 #include "crab/mem/copy.hpp"
 #include "crab/mem/forward.hpp"
 #include "crab/mem/mem.hpp"
@@ -82,6 +84,7 @@
 #include "crab/opt/concepts.hpp"
 #include "crab/opt/fallible.hpp"
 #include "crab/opt/forward.hpp"
+#include "crab/opt/niche.hpp"
 #include "crab/opt/none.hpp"
 #include "crab/opt/opt.hpp"
 #include "crab/opt/some.hpp"
@@ -93,19 +96,31 @@
 #include "crab/ref/is.hpp"
 #include "crab/ref/is_exact.hpp"
 #include "crab/ref/ref.hpp"
+#include "crab/ref/type_id.hpp"
 
 #include "crab/boxed/Box.hpp"
+#include "crab/boxed/InlineBox.hpp"
 #include "crab/boxed/boxed.hpp"
 #include "crab/boxed/forward.hpp"
 
 #include "crab/any/AnyOf.hpp"
+#include "crab/any/CompactAnyOf.hpp"
+#include "crab/any/VariantVec.hpp"
 #include "crab/any/any.hpp"
 #include "crab/any/forward.hpp"
+#include "crab/any/visit.hpp"
 
+#include "crab/rc/Arc.hpp"
+#include "crab/rc/AtomicArc.hpp"
+#include "crab/rc/BiasedArc.hpp"
+#include "crab/rc/Intrusive.hpp"
 #include "crab/rc/Rc.hpp"
+#include "crab/rc/RcSlice.hpp"
 
+#include "crab/result/AnyError.hpp"
 #include "crab/result/Err.hpp"
 #include "crab/result/Error.hpp"
+#include "crab/result/ErrorCode.hpp"
 #include "crab/result/Ok.hpp"
 #include "crab/result/Result.hpp"
 #include "crab/result/concepts.hpp"
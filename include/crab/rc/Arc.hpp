@@ -0,0 +1,333 @@
+// NOLINTBEGIN(*-explicit-constructor)
+#pragma once
+
+#include "crab/boxed/Box.hpp"
+#include "crab/ref/implicit_cast.hpp"
+#include "crab/mem/take.hpp"
+
+#include "crab/rc/impl/ControlBlock.hpp"
+#include "crab/rc/impl/RcBase.hpp"
+#include "crab/rc/impl/RcStorage.hpp"
+
+namespace crab::rc {
+
+  template<typename T>
+  class Arc;
+
+  template<typename T>
+  class ArcMut;
+
+  /**
+   * Thread-safe (atomically reference-counted) version of RcMut<T>. Note that only the reference count is thread-safe,
+   * synchronising access to the shared resource itself is still up to the user.
+   */
+  template<typename T>
+  class ArcMut final : public impl::RcBase<T, ArcMut, impl::AtomicCounter> {
+    static_assert(ty::non_const<T>, "Cannot have a ArcMut of a const T, consider using Arc<T>");
+
+    using Base = impl::RcBase<T, ArcMut, impl::AtomicCounter>;
+
+    explicit CRAB_INLINE ArcMut(T* raw_owned_ptr, Base::Counter* raw_counter_ptr):
+        Base{raw_owned_ptr, raw_counter_ptr} {}
+
+  public:
+
+    template<typename>
+    friend class Arc;
+
+    template<typename>
+    friend class ArcMut;
+
+    template<std::derived_from<T> Derived>
+    CRAB_INLINE constexpr ArcMut(const ArcMut<Derived>& derived): ArcMut{derived.template upcast<T>()} {}
+
+    template<std::derived_from<T> Derived>
+    CRAB_INLINE constexpr ArcMut(ArcMut<Derived>&& derived): ArcMut{mem::move(derived).template upcast<T>()} {}
+
+    CRAB_INLINE constexpr ArcMut(boxed::Box<T> from): ArcMut{from_owned_unchecked(std::move(from).into_raw())} {}
+
+    template<std::derived_from<T> Derived>
+    CRAB_INLINE constexpr auto operator=(const ArcMut<Derived>& derived) -> ArcMut& {
+      operator=(derived.template upcast<T>());
+      return *this;
+    }
+
+    template<std::derived_from<T> Derived>
+    CRAB_INLINE constexpr auto operator=(ArcMut<Derived>&& derived) -> ArcMut& {
+      operator=(mem::move(derived).template upcast<T>());
+      return *this;
+    }
+
+    [[nodiscard]] CRAB_INLINE constexpr auto operator->() const -> T* {
+      return as_ptr_mut();
+    }
+
+    [[nodiscard]] CRAB_INLINE constexpr auto operator*() const -> T& {
+      return as_mut();
+    }
+
+    [[nodiscard]] CRAB_INLINE constexpr operator T&() const {
+      return as_mut();
+    }
+
+    [[nodiscard]] CRAB_INLINE constexpr operator T*() const {
+      return as_ptr_mut();
+    }
+
+    [[nodiscard]] constexpr auto as_ptr_mut() const -> T* {
+      this->assert_valid();
+      return this->data;
+    }
+
+    /**
+     * Returns a mutable reference to the value inside
+     */
+    [[nodiscard]] constexpr auto as_mut() const -> T& {
+      this->assert_valid();
+      return *this->data;
+    }
+
+    /**
+     * Returns a copy of this ArcMut
+     */
+    [[nodiscard]] auto clone() const -> ArcMut {
+      return *this;
+    }
+
+    /**
+     * Unsafe factory method that takes in an *unmanaged* pointer (allocated with 'new') to construct shared ownership
+     * around it. This allocates a separate control block, prefer make_arc_mut when constructing a new value.
+     */
+    [[nodiscard]] static constexpr auto from_owned_unchecked(T* data_ptr) -> ArcMut {
+      return ArcMut{data_ptr, new impl::PtrCounter<T, impl::AtomicCounter>{data_ptr}};
+    }
+
+    /**
+     * Unsafe factory method that takes in an *unmanaged* pointer along with the existing counter that owns it.
+     */
+    [[nodiscard]] static constexpr auto from_owned_unchecked(T* data_ptr, Base::Counter* counter_ptr) -> ArcMut {
+      return ArcMut{data_ptr, counter_ptr};
+    }
+
+    using Base::get_ref_count;
+    using Base::get_weak_ref_count;
+    using Base::is_unique;
+    using Base::into_box;
+    using Base::try_unwrap;
+    using Base::into_inner;
+    using Base::make_mut;
+    using Base::as_ptr;
+    using Base::as_ref;
+    using Base::is_valid;
+    using Base::upcast;
+    using Base::downcast;
+  };
+
+  /**
+   * Thread-safe (atomically reference-counted) version of Rc<T>, this can be freely cloned & dropped across threads.
+   */
+  template<typename T>
+  class Arc final : public impl::RcBase<const T, Arc, impl::AtomicCounter> {
+    static_assert(ty::non_const<T>);
+
+    using Base = impl::RcBase<const T, Arc, impl::AtomicCounter>;
+
+    explicit CRAB_INLINE Arc(const T* data_ptr, Base::Counter* counter_ptr): Base{data_ptr, counter_ptr} {}
+
+  public:
+
+    template<typename>
+    friend class Arc;
+
+    template<typename>
+    friend class ArcMut;
+
+    CRAB_INLINE constexpr Arc(ArcMut<T>&& from):
+        Base{
+          mem::take(from.data),
+          mem::take(from.counter),
+        } {
+      crab_check(this->is_valid(), "Cannot move from a moved-from ArcMut");
+    }
+
+    CRAB_INLINE constexpr Arc(const ArcMut<T>& from): Arc{reinterpret_cast<const Arc&>(from)} {
+      // SAFETY: reinterpret_cast is valid here, forall T: Arc<T> has the exact same layout and data as ArcMut<T>
+    }
+
+    template<std::derived_from<T> Derived>
+    CRAB_INLINE constexpr Arc(const ArcMut<Derived>& derived): Arc{derived.template upcast<T>()} {}
+
+    template<std::derived_from<T> Derived>
+    CRAB_INLINE constexpr Arc(ArcMut<Derived>&& derived): Arc{mem::move(derived).template upcast<T>()} {}
+
+    CRAB_INLINE constexpr Arc(boxed::Box<T> from): Arc{from_owned_unchecked(std::move(from).into_raw())} {}
+
+    template<std::derived_from<T> Derived>
+    CRAB_INLINE constexpr auto operator=(const ArcMut<Derived>& derived) -> Arc& {
+      operator=(implicit_cast<const Arc&>(derived));
+      return *this;
+    }
+
+    template<std::derived_from<T> Derived>
+    CRAB_INLINE constexpr auto operator=(ArcMut<Derived>&& derived) -> Arc& {
+      operator=(implicit_cast<Arc&&>(mem::move(derived)));
+      return *this;
+    }
+
+    template<std::derived_from<T> Derived>
+    CRAB_INLINE constexpr Arc(const Arc<Derived>& derived): Arc{derived.template upcast<T>()} {}
+
+    template<std::derived_from<T> Derived>
+    CRAB_INLINE constexpr Arc(Arc<Derived>&& derived): Arc{mem::move(derived).template upcast<T>()} {}
+
+    template<std::derived_from<T> Derived>
+    CRAB_INLINE constexpr auto operator=(const Arc<Derived>& derived) -> Arc& {
+      operator=(derived.template upcast<T>());
+      return *this;
+    }
+
+    template<std::derived_from<T> Derived>
+    CRAB_INLINE constexpr auto operator=(Arc<Derived>&& derived) -> Arc& {
+      operator=(mem::move(derived).template upcast<T>());
+      return *this;
+    }
+
+    constexpr auto operator=(ArcMut<T>&& from) -> Arc& {
+      crab_check(from.is_valid(), "Cannot move from partially constructed ArcMut");
+
+      if (this->counter == from.counter) [[unlikely]] {
+        return *this;
+      }
+
+      // destruct old counter & data
+      this->destroy();
+
+      // destruct old counter & data
+      this->data = mem::take(from.data);
+      this->counter = mem::take(from.counter);
+
+      return *this;
+    }
+
+    /**
+     * Copy assignment operator from an ArcMut of the same type
+     */
+    constexpr auto operator=(const ArcMut<T>& from) -> Arc& {
+      // SAFETY: reinterpret_cast is valid here, forall T: Arc<T> has the exact same layout and data as ArcMut<T>
+      operator=(reinterpret_cast<const Arc&>(from));
+      return *this;
+    }
+
+    /**
+     * Conversion operator that is any alias to Arc::as_ref
+     */
+    [[nodiscard]] CRAB_INLINE constexpr operator const T&() const {
+      return this->as_ref();
+    }
+
+    /**
+     * Conversion operator that is any alias to Arc::as_ptr
+     */
+    [[nodiscard]] CRAB_INLINE constexpr operator const T*() const {
+      return this->as_ptr();
+    }
+
+    /**
+     * Returns a copy of this Arc
+     */
+    [[nodiscard]] auto clone() const -> Arc {
+      return *this;
+    }
+
+    /**
+     * Unsafe factory method that takes in an *unmanaged* pointer (allocated with 'new') to construct shared ownership
+     * around it. This allocates a separate control block, prefer make_arc when constructing a new value.
+     */
+    [[nodiscard]] static constexpr auto from_owned_unchecked(const T* owned_ptr) -> Arc {
+      return Arc{owned_ptr, new impl::PtrCounter<const T, impl::AtomicCounter>{owned_ptr}};
+    }
+
+    /**
+     * Unsafe factory method that takes in an *unmanaged* pointer along with the existing counter that owns it.
+     */
+    [[nodiscard]] static constexpr auto from_owned_unchecked(const T* owned_ptr, Base::Counter* counter_ptr) -> Arc {
+      return Arc{owned_ptr, counter_ptr};
+    }
+
+    using Base::get_ref_count;
+
+    using Base::get_weak_ref_count;
+
+    using Base::is_unique;
+
+    using Base::into_box;
+    using Base::try_unwrap;
+    using Base::into_inner;
+    using Base::make_mut;
+
+    using Base::operator->;
+
+    using Base::operator*;
+
+    using Base::as_ptr;
+
+    using Base::as_ref;
+
+    using Base::is_valid;
+
+    using Base::upcast;
+
+    using Base::downcast;
+  };
+
+  /// Specialization for fmt to be able to format a Arc<T> if T is formattable.
+  template<typename T>
+  [[nodiscard]] auto format_as(const Arc<T>& rc) -> const T& {
+    return rc.as_ref();
+  }
+
+  /// Specialization for fmt to be able to format a ArcMut<T> if T is formattable.
+  template<typename T>
+  [[nodiscard]] auto format_as(const ArcMut<T>& rc) -> const T& {
+    return rc.as_ref();
+  }
+
+  // Constructs the type T from the given arguments and creates an Arc around it. Note unlike ArcMut, an Arc can never be
+  // converted into mutable safely.
+  //
+  // The value is constructed inline with its counter, so this is a single allocation.
+  template<ty::non_const T, typename... Args>
+  [[nodiscard]] constexpr auto make_arc(Args&&... args) -> Arc<T> {
+    static_assert(std::constructible_from<T, Args...>, "Cannot construct type from the given arguments");
+
+    auto* const block{new impl::InlineCounter<T, impl::AtomicCounter>{std::forward<Args>(args)...}};
+    return Arc<T>::from_owned_unchecked(block->value_ptr(), block);
+  }
+
+  // Constructs the type T from the given arguments and creates an ArcMut around it
+  //
+  // The value is constructed inline with its counter, so this is a single allocation.
+  template<ty::non_const T, typename... Args>
+  requires std::constructible_from<T, Args...>
+  [[nodiscard]] constexpr auto make_arc_mut(Args&&... args) -> ArcMut<T> {
+    static_assert(std::constructible_from<T, Args...>, "Cannot construct type from the given arguments");
+
+    auto* const block{new impl::InlineCounter<T, impl::AtomicCounter>{std::forward<Args>(args)...}};
+    return ArcMut<T>::from_owned_unchecked(block->value_ptr(), block);
+  }
+
+}
+
+namespace crab {
+  using ::crab::rc::make_arc;
+  using ::crab::rc::make_arc_mut;
+
+  namespace prelude {
+    using ::crab::rc::Arc;
+    using ::crab::rc::ArcMut;
+  }
+}
+
+CRAB_PRELUDE_GUARD;
+
+// NOLINTEND(*-explicit-constructor)
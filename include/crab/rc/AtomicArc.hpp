@@ -0,0 +1,163 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include "crab/core.hpp"
+#include "crab/core/discard.hpp"
+#include "crab/mem/move.hpp"
+#include "crab/rc/Arc.hpp"
+
+namespace crab::rc {
+
+  namespace impl {
+    /// Number of independent reader counters in an AtomicArc, readers are spread across these to avoid every load
+    /// contending on the same cache line.
+    inline constexpr usize READER_STRIPES{16};
+
+    /**
+     * Reader counters for one AtomicArc stripe, there is one counter per epoch parity. Padded to a cache line so that
+     * stripes do not falsely share.
+     */
+    struct alignas(64) ReaderStripe final {
+      std::array<std::atomic_size_t, 2> active{};
+    };
+
+    /**
+     * Stripe that the calling thread uses for all AtomicArc loads, assigned round-robin the first time a thread loads.
+     */
+    [[nodiscard]] inline auto reader_stripe_index() -> usize {
+      static std::atomic_size_t next_index{0};
+      static thread_local const usize index{next_index.fetch_add(1, std::memory_order_relaxed) % READER_STRIPES};
+      return index;
+    }
+  }
+
+  /**
+   * A shared, atomically replaceable Arc<T> (eg. a configuration snapshot read by many threads and occasionally
+   * replaced by a writer).
+   *
+   * Readers are wait-free: AtomicArc::load never blocks, takes a lock or retries, it only marks itself as active in a
+   * per-thread stripe, clones the current Arc and unmarks itself. Writers (store / exchange / compare_exchange) are
+   * serialised with each other, and after publishing a new value they wait for a grace period (every reader that could
+   * still be looking at the old value to finish) before releasing their reference to it. This is the same two phase
+   * scheme used by userspace RCU, with the writer flipping the reader epoch twice so that it cannot be starved by a
+   * constant stream of new readers.
+   */
+  template<typename T>
+  class AtomicArc final {
+
+    /// Heap cell holding the published reference, this is what readers race to see and what a writer reclaims.
+    struct Node final {
+      Arc<T> value;
+    };
+
+  public:
+
+    explicit AtomicArc(Arc<T> value): current{new Node{mem::move(value)}} {}
+
+    AtomicArc(const AtomicArc&) = delete;
+
+    AtomicArc(AtomicArc&&) = delete;
+
+    auto operator=(const AtomicArc&) -> AtomicArc& = delete;
+
+    auto operator=(AtomicArc&&) -> AtomicArc& = delete;
+
+    ~AtomicArc() {
+      delete current.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Gets a new reference to the currently published value, this is wait-free.
+     */
+    [[nodiscard]] auto load() const -> Arc<T> {
+      impl::ReaderStripe& stripe{stripes[impl::reader_stripe_index()]};
+
+      // the epoch only decides which counter we use so writers can make progress, any of the two is safe
+      std::atomic_size_t& active{stripe.active[epoch.load(std::memory_order_relaxed) & 1]};
+
+      active.fetch_add(1, std::memory_order_seq_cst);
+      Arc<T> value{current.load(std::memory_order_seq_cst)->value};
+      active.fetch_sub(1, std::memory_order_release);
+
+      return value;
+    }
+
+    /**
+     * Publishes a new value, the previous value is released once no reader can be looking at it.
+     */
+    auto store(Arc<T> value) -> void {
+      crab::discard(exchange(mem::move(value)));
+    }
+
+    /**
+     * Publishes a new value, giving back the previously published one.
+     */
+    [[nodiscard]] auto exchange(Arc<T> value) -> Arc<T> {
+      const std::scoped_lock lock{writer};
+      return exchange_locked(mem::move(value));
+    }
+
+    /**
+     * Publishes 'desired' only if the currently published value is the same resource as 'expected' (compared by
+     * identity), returns whether the value was replaced. On failure 'expected' is updated to the current value.
+     */
+    [[nodiscard]] auto compare_exchange(Arc<T>& expected, Arc<T> desired) -> bool {
+      const std::scoped_lock lock{writer};
+
+      // writers are serialised, so the current node cannot change underneath us
+      const Arc<T>& published{current.load(std::memory_order_relaxed)->value};
+
+      if (published.as_ptr() != expected.as_ptr()) {
+        expected = published;
+        return false;
+      }
+
+      expected = exchange_locked(mem::move(desired));
+      return true;
+    }
+
+  private:
+
+    [[nodiscard]] auto exchange_locked(Arc<T> value) -> Arc<T> {
+      Node* const previous{current.exchange(new Node{mem::move(value)}, std::memory_order_seq_cst)};
+
+      synchronize();
+
+      Arc<T> released{mem::move(previous->value)};
+      delete previous;
+      return released;
+    }
+
+    /**
+     * Waits until every reader that started before the current node was swapped out has finished. Any reader that
+     * increments its counter after we observe it at zero is guaranteed to see the new node, so each counter only needs
+     * to be seen at zero once.
+     */
+    auto synchronize() -> void {
+      for (usize phase = 0; phase < 2; phase++) {
+        const usize previous_epoch{epoch.fetch_add(1, std::memory_order_seq_cst)};
+
+        for (impl::ReaderStripe& stripe: stripes) {
+          while (stripe.active[previous_epoch & 1].load(std::memory_order_seq_cst) != 0) {
+            std::this_thread::yield();
+          }
+        }
+      }
+    }
+
+    std::atomic<Node*> current;
+    mutable std::atomic_size_t epoch{0};
+    mutable std::array<impl::ReaderStripe, impl::READER_STRIPES> stripes{};
+    std::mutex writer;
+  };
+}
+
+namespace crab::prelude {
+  using ::crab::rc::AtomicArc;
+}
+
+CRAB_PRELUDE_GUARD;
@@ -0,0 +1,155 @@
+// NOLINTBEGIN(*-explicit-constructor)
+#pragma once
+
+#include "crab/boxed/Box.hpp"
+#include "crab/mem/take.hpp"
+
+#include "crab/rc/impl/BiasedCounter.hpp"
+#include "crab/rc/impl/ControlBlock.hpp"
+#include "crab/rc/impl/RcBase.hpp"
+#include "crab/rc/impl/RcStorage.hpp"
+
+namespace crab::rc {
+
+  /**
+   * Thread-safe shared reference like Arc<T>, but with reference counting biased towards the thread that created it.
+   *
+   * Clones and drops on the creating (owner) thread are plain, non-atomic updates, so a BiasedArc that mostly stays on
+   * one thread costs about as much as an Rc<T>. Any other thread can still freely clone and drop it, those go through an
+   * atomic count that is merged with the owner's once the owner drops its last reference. If another thread drops
+   * the last reference while the owner is still counting separately, the resource is only freed the next time the owner
+   * thread drops or creates a BiasedArc (or when it exits).
+   *
+   * The reference count is exact on the owner thread, on other threads it is only exact once the owner has dropped all
+   * of its references. Before that it is a conservative estimate, so is_unique / make_mut never treat a reference held
+   * by another thread as unique.
+   *
+   * Prefer Arc<T> for values that are handed off to other threads for good, as every reference count update after the
+   * hand-off would take the slower shared path.
+   */
+  template<typename T>
+  class BiasedArc final : public impl::RcBase<const T, BiasedArc, impl::BiasedCounter> {
+    static_assert(ty::non_const<T>);
+
+    using Base = impl::RcBase<const T, BiasedArc, impl::BiasedCounter>;
+
+    explicit CRAB_INLINE BiasedArc(const T* data_ptr, Base::Counter* counter_ptr): Base{data_ptr, counter_ptr} {}
+
+  public:
+
+    template<typename>
+    friend class BiasedArc;
+
+    CRAB_INLINE constexpr BiasedArc(boxed::Box<T> from): BiasedArc{from_owned_unchecked(std::move(from).into_raw())} {}
+
+    template<std::derived_from<T> Derived>
+    CRAB_INLINE constexpr BiasedArc(const BiasedArc<Derived>& derived): BiasedArc{derived.template upcast<T>()} {}
+
+    template<std::derived_from<T> Derived>
+    CRAB_INLINE constexpr BiasedArc(BiasedArc<Derived>&& derived): BiasedArc{mem::move(derived).template upcast<T>()} {}
+
+    template<std::derived_from<T> Derived>
+    CRAB_INLINE constexpr auto operator=(const BiasedArc<Derived>& derived) -> BiasedArc& {
+      operator=(derived.template upcast<T>());
+      return *this;
+    }
+
+    template<std::derived_from<T> Derived>
+    CRAB_INLINE constexpr auto operator=(BiasedArc<Derived>&& derived) -> BiasedArc& {
+      operator=(mem::move(derived).template upcast<T>());
+      return *this;
+    }
+
+    /**
+     * Conversion operator that is any alias to BiasedArc::as_ref
+     */
+    [[nodiscard]] CRAB_INLINE constexpr operator const T&() const {
+      return this->as_ref();
+    }
+
+    /**
+     * Conversion operator that is any alias to BiasedArc::as_ptr
+     */
+    [[nodiscard]] CRAB_INLINE constexpr operator const T*() const {
+      return this->as_ptr();
+    }
+
+    /**
+     * Returns a copy of this BiasedArc
+     */
+    [[nodiscard]] auto clone() const -> BiasedArc {
+      return *this;
+    }
+
+    /**
+     * Unsafe factory method that takes in an *unmanaged* pointer (allocated with 'new') to construct shared ownership
+     * around it, owned by the calling thread. This allocates a separate control block, prefer make_biased_arc when
+     * constructing a new value.
+     */
+    [[nodiscard]] static constexpr auto from_owned_unchecked(const T* owned_ptr) -> BiasedArc {
+      return BiasedArc{owned_ptr, new impl::PtrCounter<const T, impl::BiasedCounter>{owned_ptr}};
+    }
+
+    /**
+     * Unsafe factory method that takes in an *unmanaged* pointer along with the existing counter that owns it.
+     */
+    [[nodiscard]] static constexpr auto from_owned_unchecked(const T* owned_ptr, Base::Counter* counter_ptr)
+      -> BiasedArc {
+      return BiasedArc{owned_ptr, counter_ptr};
+    }
+
+    using Base::get_ref_count;
+
+    using Base::get_weak_ref_count;
+
+    using Base::is_unique;
+
+    using Base::into_box;
+    using Base::try_unwrap;
+    using Base::into_inner;
+    using Base::make_mut;
+
+    using Base::operator->;
+
+    using Base::operator*;
+
+    using Base::as_ptr;
+
+    using Base::as_ref;
+
+    using Base::is_valid;
+
+    using Base::upcast;
+
+    using Base::downcast;
+  };
+
+  /// Specialization for fmt to be able to format a BiasedArc<T> if T is formattable.
+  template<typename T>
+  [[nodiscard]] auto format_as(const BiasedArc<T>& rc) -> const T& {
+    return rc.as_ref();
+  }
+
+  // Constructs the type T from the given arguments and creates a BiasedArc around it, owned by the calling thread.
+  //
+  // The value is constructed inline with its counter, so this is a single allocation.
+  template<ty::non_const T, typename... Args>
+  [[nodiscard]] auto make_biased_arc(Args&&... args) -> BiasedArc<T> {
+    static_assert(std::constructible_from<T, Args...>, "Cannot construct type from the given arguments");
+
+    auto* const block{new impl::InlineCounter<T, impl::BiasedCounter>{std::forward<Args>(args)...}};
+    return BiasedArc<T>::from_owned_unchecked(block->value_ptr(), block);
+  }
+}
+
+namespace crab {
+  using ::crab::rc::make_biased_arc;
+
+  namespace prelude {
+    using ::crab::rc::BiasedArc;
+  }
+}
+
+CRAB_PRELUDE_GUARD;
+
+// NOLINTEND(*-explicit-constructor)
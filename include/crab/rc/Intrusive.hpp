@@ -0,0 +1,297 @@
+// NOLINTBEGIN(*-explicit-constructor)
+#pragma once
+
+#include <concepts>
+
+#include "crab/assertion/check.hpp"
+#include "crab/core/unsafe.hpp"
+#include "crab/mem/address_of.hpp"
+#include "crab/mem/take.hpp"
+#include "crab/opt/Option.hpp"
+#include "crab/ref/type_id.hpp"
+
+#include "crab/rc/impl/Counter.hpp"
+#include "crab/rc/impl/RcStorage.hpp"
+
+namespace crab::rc {
+
+  template<typename T>
+  class IntrusiveRc;
+
+  /**
+   * Base class that embeds a reference count directly inside of the object, making it usable with IntrusiveRc<T>.
+   * 'Count' is the counting policy (impl::LocalCount or impl::AtomicCount), prefer the Intrusive / AtomicIntrusive
+   * aliases.
+   *
+   * Copying or assigning an object does not copy its count, a copy is a new object with no references to it yet.
+   */
+  template<typename Count>
+  class BasicIntrusive {
+  protected:
+
+    BasicIntrusive() = default;
+
+    CRAB_INLINE BasicIntrusive(const BasicIntrusive&): BasicIntrusive{} {}
+
+    CRAB_INLINE auto operator=(const BasicIntrusive&) -> BasicIntrusive& {
+      return *this;
+    }
+
+    ~BasicIntrusive() = default;
+
+  private:
+
+    template<typename>
+    friend class IntrusiveRc;
+
+    mutable Count crab_intrusive_count{0};
+  };
+
+  /// Embedded single threaded reference count, see IntrusiveRc<T>
+  using Intrusive = BasicIntrusive<impl::LocalCount>;
+
+  /// Embedded thread-safe reference count, see IntrusiveRc<T>
+  using AtomicIntrusive = BasicIntrusive<impl::AtomicCount>;
+
+  /// Whether T embeds its own reference count (derives from Intrusive / AtomicIntrusive).
+  template<typename T>
+  concept intrusive = std::derived_from<std::remove_const_t<T>, Intrusive>
+                   or std::derived_from<std::remove_const_t<T>, AtomicIntrusive>;
+
+  /**
+   * Reference-counted smart pointer to a T that stores its own count (see Intrusive / AtomicIntrusive). Because there
+   * is no separate control block, an IntrusiveRc<T> is a single pointer wide, and a new reference can be made from any
+   * raw T* that is known to be managed by an IntrusiveRc.
+   *
+   * Access to the object is as mutable as T, use IntrusiveRc<const T> for shared immutable access. Whether the count is
+   * thread-safe is decided by the base class of T, not by IntrusiveRc.
+   */
+  template<typename T>
+  class IntrusiveRc final {
+    explicit CRAB_INLINE constexpr IntrusiveRc(T* raw_ptr): data{raw_ptr} {}
+
+  public:
+
+    template<typename>
+    friend class IntrusiveRc;
+
+    template<std::derived_from<T> Derived>
+    CRAB_INLINE constexpr IntrusiveRc(const IntrusiveRc<Derived>& derived): IntrusiveRc{derived.template upcast<T>()} {}
+
+    template<std::derived_from<T> Derived>
+    CRAB_INLINE constexpr IntrusiveRc(IntrusiveRc<Derived>&& derived):
+        IntrusiveRc{mem::move(derived).template upcast<T>()} {}
+
+    IntrusiveRc(const IntrusiveRc& from): data{from.data} {
+      crab_check(from.is_valid(), "Cannot copy from a moved-from IntrusiveRc");
+      count().increment();
+    }
+
+    IntrusiveRc(IntrusiveRc&& from) noexcept: data{mem::take(from.data)} {}
+
+    constexpr auto operator=(const IntrusiveRc& from) -> IntrusiveRc& {
+      if (mem::address_of(from) == this) [[unlikely]] {
+        return *this;
+      }
+
+      crab_check(from.is_valid(), "Cannot copy from a moved-from / invalid IntrusiveRc");
+
+      if (data == from.data) [[unlikely]] {
+        return *this;
+      }
+
+      destroy();
+
+      data = from.data;
+      count().increment();
+
+      return *this;
+    }
+
+    constexpr auto operator=(IntrusiveRc&& from) noexcept -> IntrusiveRc& {
+      if (mem::address_of(from) == this) [[unlikely]] {
+        return *this;
+      }
+
+      if (data == from.data) [[unlikely]] {
+        return *this;
+      }
+
+      destroy();
+      data = mem::take(from.data);
+
+      return *this;
+    }
+
+    ~IntrusiveRc() {
+      // checked here rather than on the class so that T can hold IntrusiveRc<T> (eg. a linked node) while incomplete
+      static_assert(intrusive<T>, "IntrusiveRc<T> requires T to derive from rc::Intrusive or rc::AtomicIntrusive");
+      destroy();
+    }
+
+    [[nodiscard]] CRAB_INLINE constexpr auto operator->() const -> T* {
+      return as_ptr();
+    }
+
+    [[nodiscard]] CRAB_INLINE constexpr auto operator*() const -> T& {
+      return as_ref();
+    }
+
+    [[nodiscard]] CRAB_INLINE constexpr operator T&() const {
+      return as_ref();
+    }
+
+    [[nodiscard]] CRAB_INLINE constexpr auto as_ptr() const -> T* {
+      assert_valid();
+      return data;
+    }
+
+    [[nodiscard]] CRAB_INLINE constexpr auto as_ref() const -> T& {
+      assert_valid();
+      return *data;
+    }
+
+    [[nodiscard]] constexpr auto get_ref_count() const -> usize {
+      assert_valid();
+      return count().load();
+    }
+
+    /**
+     * Returns whether or not this is the only existing reference to the object.
+     */
+    [[nodiscard]] constexpr auto is_unique() const -> bool {
+      return get_ref_count() == 1;
+    }
+
+    /**
+     * Returns if this instance is in a moved-from state or not, see RcBase::is_valid.
+     */
+    [[nodiscard]] constexpr auto is_valid() const -> bool {
+      return data != nullptr;
+    }
+
+    /**
+     * Returns a copy of this IntrusiveRc
+     */
+    [[nodiscard]] auto clone() const -> IntrusiveRc {
+      return *this;
+    }
+
+    /**
+     * Gives up this reference without decrementing the count, so that the pointer can be handed to code that cannot
+     * hold an IntrusiveRc (eg. a C callback's user data). The reference must be given back with IntrusiveRc::from_raw.
+     */
+    [[nodiscard]] auto into_raw() && -> T* {
+      assert_valid();
+      return mem::take(data);
+    }
+
+    /**
+     * Takes back a reference that was given up with IntrusiveRc::into_raw, this does not change the count.
+     *
+     * # Safety
+     * The pointer must have come from IntrusiveRc::into_raw, and can only be given back once.
+     */
+    [[nodiscard]] static constexpr auto from_raw(unsafe_fn, T* raw_ptr) -> IntrusiveRc {
+      return IntrusiveRc{raw_ptr};
+    }
+
+    /**
+     * Unsafe factory method that makes a new reference to a pointer allocated with 'new', this is valid both for a
+     * freshly allocated T (with no references yet) and for any T that is already managed by an IntrusiveRc, as the count
+     * lives inside of the object.
+     */
+    [[nodiscard]] static constexpr auto from_owned_unchecked(T* owned_ptr) -> IntrusiveRc {
+      IntrusiveRc rc{owned_ptr};
+
+      if (owned_ptr != nullptr) {
+        rc.count().increment();
+      }
+
+      return rc;
+    }
+
+    template<typename U>
+    requires std::derived_from<std::remove_const_t<T>, std::remove_const_t<U>>
+         and (ty::is_const<U> or ty::non_const<T>)
+    [[nodiscard]] auto upcast() const& -> IntrusiveRc<U> {
+      return IntrusiveRc<U>::from_owned_unchecked(as_ptr());
+    }
+
+    template<typename U>
+    requires std::derived_from<std::remove_const_t<T>, std::remove_const_t<U>>
+         and (ty::is_const<U> or ty::non_const<T>)
+    [[nodiscard]] auto upcast() && -> IntrusiveRc<U> {
+      assert_valid();
+      return IntrusiveRc<U>{mem::take(data)};
+    }
+
+    template<std::derived_from<T> U>
+    [[nodiscard]] auto downcast() const& -> opt::Option<IntrusiveRc<U>> {
+      return clone().template downcast<U>();
+    }
+
+    template<std::derived_from<T> U>
+    [[nodiscard]] auto downcast() && -> opt::Option<IntrusiveRc<U>> {
+      assert_valid();
+
+      auto* casted = ref::dynamic_downcast<U>(data);
+
+      if (casted == nullptr) {
+        return {};
+      }
+
+      data = nullptr;
+      return {IntrusiveRc<U>{casted}};
+    }
+
+  private:
+
+    [[nodiscard]] CRAB_INLINE constexpr auto count() const -> auto& {
+      return data->crab_intrusive_count;
+    }
+
+    constexpr auto destroy() -> void {
+      if (data == nullptr) [[unlikely]] {
+        return;
+      }
+
+      if (count().decrement()) {
+        delete data;
+      }
+
+      data = nullptr;
+    }
+
+    CRAB_INLINE constexpr auto assert_valid(const SourceLocation& loc = SourceLocation::current()) const {
+      crab_check_with_location(is_valid(), loc, "Invalid use of moved-from IntrusiveRc");
+    }
+
+    T* data;
+  };
+
+  /// Specialization for fmt to be able to format an IntrusiveRc<T> if T is formattable.
+  template<typename T>
+  [[nodiscard]] auto format_as(const IntrusiveRc<T>& rc) -> const T& {
+    return rc.as_ref();
+  }
+
+  /// Constructs the type T from the given arguments on the heap and creates an IntrusiveRc around it.
+  template<intrusive T, typename... Args>
+  requires std::constructible_from<std::remove_const_t<T>, Args...>
+  [[nodiscard]] auto make_intrusive(Args&&... args) -> IntrusiveRc<T> {
+    return IntrusiveRc<T>::from_owned_unchecked(new std::remove_const_t<T>(std::forward<Args>(args)...));
+  }
+}
+
+namespace crab {
+  using ::crab::rc::make_intrusive;
+
+  namespace prelude {
+    using ::crab::rc::IntrusiveRc;
+  }
+}
+
+CRAB_PRELUDE_GUARD;
+
+// NOLINTEND(*-explicit-constructor)
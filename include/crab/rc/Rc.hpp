@@ -5,13 +5,15 @@
 #include "crab/ref/implicit_cast.hpp"
 #include "crab/mem/take.hpp"
 
+#include "crab/rc/impl/ControlBlock.hpp"
 #include "crab/rc/impl/RcBase.hpp"
 #include "crab/rc/impl/RcStorage.hpp"
+#include "crab/rc/Weak.hpp"
 
 /**
  * @namespace crab::rc
- * This namespace contains crab's reference-counting smart pointer types: Rc<T> and RcMut<T>, along with the
- * corresponding make_rc(_mut) constructor functions
+ * This namespace contains crab's reference-counting smart pointer types: Rc<T> and RcMut<T> (and their thread-safe
+ * counterparts Arc<T> and ArcMut<T>) and the non-owning Weak<T>, along with the corresponding make_rc(_mut) / make_arc(_mut) constructor functions
  */
 namespace crab::rc {}
 
@@ -50,7 +52,7 @@ namespace crab::rc {
     template<std::derived_from<T> Derived>
     CRAB_INLINE constexpr RcMut(RcMut<Derived>&& derived): RcMut{mem::move(derived).template upcast<T>()} {}
 
-    CRAB_INLINE constexpr RcMut(boxed::Box<T> from): RcMut{std::move(from).into_raw(), new Base::Counter} {}
+    CRAB_INLINE constexpr RcMut(boxed::Box<T> from): RcMut{from_owned_unchecked(std::move(from).into_raw())} {}
 
     template<std::derived_from<T> Derived>
     CRAB_INLINE constexpr auto operator=(const RcMut<Derived>& derived) -> RcMut& {
@@ -101,17 +103,36 @@ namespace crab::rc {
     }
 
     /**
-     * Unsafe factory method that takes in an *unmanaged* pointer (+ possibly an existing counter) to construct
-     * shared ownership around it.
+     * Creates a new weak reference to this resource, see Weak<T>.
      */
-    [[nodiscard]]
-    static constexpr auto from_owned_unchecked(T* data_ptr, Base::Counter* counter_ptr = new Base::Counter) -> RcMut {
+    [[nodiscard]] auto downgrade() const -> Weak<T> {
+      this->assert_valid();
+      this->counter->increment_weak();
+      return Weak<T>::from_owned_unchecked(this->data, this->counter);
+    }
+
+    /**
+     * Unsafe factory method that takes in an *unmanaged* pointer (allocated with 'new') to construct shared ownership
+     * around it. This allocates a separate control block, prefer make_rc_mut when constructing a new value.
+     */
+    [[nodiscard]] static constexpr auto from_owned_unchecked(T* data_ptr) -> RcMut {
+      return RcMut{data_ptr, new impl::PtrCounter<T>{data_ptr}};
+    }
+
+    /**
+     * Unsafe factory method that takes in an *unmanaged* pointer along with the existing counter that owns it.
+     */
+    [[nodiscard]] static constexpr auto from_owned_unchecked(T* data_ptr, Base::Counter* counter_ptr) -> RcMut {
       return RcMut{data_ptr, counter_ptr};
     }
 
     using Base::get_ref_count;
     using Base::get_weak_ref_count;
     using Base::is_unique;
+    using Base::into_box;
+    using Base::try_unwrap;
+    using Base::into_inner;
+    using Base::make_mut;
     using Base::as_ptr;
     using Base::as_ref;
     using Base::is_valid;
@@ -153,7 +174,7 @@ namespace crab::rc {
     template<std::derived_from<T> Derived>
     CRAB_INLINE constexpr Rc(RcMut<Derived>&& derived): Rc{mem::move(derived).template upcast<T>()} {}
 
-    CRAB_INLINE constexpr Rc(boxed::Box<T> from): Rc{std::move(from).into_raw(), new Base::Counter} {}
+    CRAB_INLINE constexpr Rc(boxed::Box<T> from): Rc{from_owned_unchecked(std::move(from).into_raw())} {}
 
     template<std::derived_from<T> Derived>
     CRAB_INLINE constexpr auto operator=(const RcMut<Derived>& derived) -> Rc& {
@@ -197,7 +218,7 @@ namespace crab::rc {
 
       // destruct old counter & data
       this->data = mem::take(from.data);
-      this->counter = mem::take(from.data);
+      this->counter = mem::take(from.counter);
 
       return *this;
     }
@@ -233,13 +254,26 @@ namespace crab::rc {
     }
 
     /**
-     * Unsafe factory method that takes in an *unmanaged* pointer (+ possibly an existing counter) to construct
-     * shared ownership around it.
+     * Creates a new weak reference to this resource, see Weak<T>.
      */
-    [[nodiscard]] static constexpr auto from_owned_unchecked(
-      const T* owned_ptr,
-      Base::Counter* counter_ptr = new Base::Counter
-    ) -> Rc {
+    [[nodiscard]] auto downgrade() const -> Weak<T> {
+      this->assert_valid();
+      this->counter->increment_weak();
+      return Weak<T>::from_owned_unchecked(this->data, this->counter);
+    }
+
+    /**
+     * Unsafe factory method that takes in an *unmanaged* pointer (allocated with 'new') to construct shared ownership
+     * around it. This allocates a separate control block, prefer make_rc when constructing a new value.
+     */
+    [[nodiscard]] static constexpr auto from_owned_unchecked(const T* owned_ptr) -> Rc {
+      return Rc{owned_ptr, new impl::PtrCounter<const T>{owned_ptr}};
+    }
+
+    /**
+     * Unsafe factory method that takes in an *unmanaged* pointer along with the existing counter that owns it.
+     */
+    [[nodiscard]] static constexpr auto from_owned_unchecked(const T* owned_ptr, Base::Counter* counter_ptr) -> Rc {
       return Rc{owned_ptr, counter_ptr};
     }
 
@@ -249,6 +283,11 @@ namespace crab::rc {
 
     using Base::is_unique;
 
+    using Base::into_box;
+    using Base::try_unwrap;
+    using Base::into_inner;
+    using Base::make_mut;
+
     using Base::operator->;
 
     using Base::operator*;
@@ -278,26 +317,65 @@ namespace crab::rc {
 
   // Constructs the type T from the given arguments and creates an Rc around it. Note unlike RcMut, an Rc can never be
   // converted into mutable safely.
+  //
+  // The value is constructed inline with its counter, so this is a single allocation.
   template<ty::non_const T, typename... Args>
   [[nodiscard]] constexpr auto make_rc(Args&&... args) -> Rc<T> {
     static_assert(std::constructible_from<T, Args...>, "Cannot construct type from the given arguments");
-    return Rc<T>::from_owned_unchecked(new T(std::forward<Args>(args)...));
+
+    auto* const block{new impl::InlineCounter<T>{std::forward<Args>(args)...}};
+    return Rc<T>::from_owned_unchecked(block->value_ptr(), block);
   }
 
   // Constructs the type T from the given arguments and creates an RcMut around it
+  //
+  // The value is constructed inline with its counter, so this is a single allocation.
   template<ty::non_const T, typename... Args>
   requires std::constructible_from<T, Args...>
   [[nodiscard]] constexpr auto make_rc_mut(Args&&... args) -> RcMut<T> {
     static_assert(std::constructible_from<T, Args...>, "Cannot construct type from the given arguments");
 
-    return RcMut<T>::from_owned_unchecked(new T(std::forward<Args>(args)...));
+    auto* const block{new impl::InlineCounter<T>{std::forward<Args>(args)...}};
+    return RcMut<T>::from_owned_unchecked(block->value_ptr(), block);
+  }
+
+  // Constructs the type T from the given arguments and creates an Rc around it, with the value and its counter
+  // allocated (as a single allocation) by the given allocator.
+  //
+  // The allocator is kept inside of the control block, so the resulting Rc<T> is the same type (and size) as one made
+  // with make_rc. Note that a copy made by make_mut is made with the global allocator.
+  template<ty::non_const T, mem::allocator A, typename... Args>
+  [[nodiscard]] constexpr auto make_rc_in(A alloc, Args&&... args) -> Rc<T> {
+    static_assert(std::constructible_from<T, Args...>, "Cannot construct type from the given arguments");
+
+    if constexpr (std::same_as<A, mem::Global>) {
+      return make_rc<T>(std::forward<Args>(args)...);
+    } else {
+      auto* const block{impl::AllocInlineCounter<T, impl::Counter, A>::allocate(alloc, std::forward<Args>(args)...)};
+      return Rc<T>::from_owned_unchecked(block->value_ptr(), block);
+    }
+  }
+
+  // Constructs the type T from the given arguments and creates an RcMut around it, with the value and its counter
+  // allocated (as a single allocation) by the given allocator, see make_rc_in.
+  template<ty::non_const T, mem::allocator A, typename... Args>
+  requires std::constructible_from<T, Args...>
+  [[nodiscard]] constexpr auto make_rc_mut_in(A alloc, Args&&... args) -> RcMut<T> {
+    if constexpr (std::same_as<A, mem::Global>) {
+      return make_rc_mut<T>(std::forward<Args>(args)...);
+    } else {
+      auto* const block{impl::AllocInlineCounter<T, impl::Counter, A>::allocate(alloc, std::forward<Args>(args)...)};
+      return RcMut<T>::from_owned_unchecked(block->value_ptr(), block);
+    }
   }
 
 }
 
 namespace crab {
   using ::crab::rc::make_rc;
+  using ::crab::rc::make_rc_in;
   using ::crab::rc::make_rc_mut;
+  using ::crab::rc::make_rc_mut_in;
 
   namespace prelude {
     using ::crab::rc::Rc;
@@ -0,0 +1,211 @@
+// NOLINTBEGIN(*-explicit-constructor)
+#pragma once
+
+#include <span>
+
+#include "crab/assertion/check.hpp"
+#include "crab/boxed/Box.hpp"
+#include "crab/mem/address_of.hpp"
+#include "crab/mem/take.hpp"
+
+#include "crab/rc/impl/ControlBlock.hpp"
+#include "crab/rc/impl/RcStorage.hpp"
+
+namespace crab::rc {
+
+  /**
+   * Reference-counted immutable array of T, the shared counterpart to Box<T[]>.
+   *
+   * The counts, length and elements all live in one allocation, and an RcSlice<T> is a single pointer to it. Unlike
+   * Rc<Vec<T>> there is no separate vector header to go through, so reaching the elements is one pointer hop.
+   */
+  template<typename T>
+  class RcSlice final {
+    static_assert(ty::non_const<T>, "Cannot have a RcSlice of a const T, consider using RcSlice<T>");
+
+    using Block = impl::SliceCounter<T>;
+
+    explicit CRAB_INLINE constexpr RcSlice(Block* block_ptr): block{block_ptr} {}
+
+  public:
+
+    /**
+     * Moves every element of the given box into a new shared allocation.
+     */
+    RcSlice(boxed::Box<T[]> from) requires ty::movable<T>
+        : RcSlice{Block::allocate(from.size(), [&from](const usize i) -> T&& { return mem::move(from[i]); })} {}
+
+    RcSlice(const RcSlice& from): block{from.block} {
+      crab_check(from.is_valid(), "Cannot copy from a moved-from RcSlice");
+      block->increment_strong();
+    }
+
+    RcSlice(RcSlice&& from) noexcept: block{mem::take(from.block)} {}
+
+    constexpr auto operator=(const RcSlice& from) -> RcSlice& {
+      if (mem::address_of(from) == this) [[unlikely]] {
+        return *this;
+      }
+
+      crab_check(from.is_valid(), "Cannot copy from a moved-from / invalid RcSlice");
+
+      if (block == from.block) [[unlikely]] {
+        return *this;
+      }
+
+      destroy();
+
+      block = from.block;
+      block->increment_strong();
+
+      return *this;
+    }
+
+    constexpr auto operator=(RcSlice&& from) noexcept -> RcSlice& {
+      if (mem::address_of(from) == this) [[unlikely]] {
+        return *this;
+      }
+
+      if (block == from.block) [[unlikely]] {
+        return *this;
+      }
+
+      destroy();
+      block = mem::take(from.block);
+
+      return *this;
+    }
+
+    ~RcSlice() {
+      destroy();
+    }
+
+    /**
+     * Conversion operator that is an alias to RcSlice::as_span
+     */
+    [[nodiscard]] CRAB_INLINE constexpr operator std::span<const T>() const {
+      return as_span();
+    }
+
+    /**
+     * Index access, bounds checked in debug builds
+     */
+    [[nodiscard]] CRAB_INLINE constexpr auto operator[](const usize index) const -> const T& {
+      crab_dbg_check(index < size(), "RcSlice index out of bounds");
+      return as_span()[index];
+    }
+
+    /**
+     * Returns a view of the shared elements
+     */
+    [[nodiscard]] CRAB_INLINE constexpr auto as_span() const -> std::span<const T> {
+      assert_valid();
+      return block->as_span();
+    }
+
+    /**
+     * Number of elements in the slice
+     */
+    [[nodiscard]] CRAB_INLINE constexpr auto size() const -> usize {
+      return as_span().size();
+    }
+
+    /**
+     * Whether the slice has no elements
+     */
+    [[nodiscard]] CRAB_INLINE constexpr auto is_empty() const -> bool {
+      return as_span().empty();
+    }
+
+    [[nodiscard]] CRAB_INLINE constexpr auto begin() const {
+      return as_span().begin();
+    }
+
+    [[nodiscard]] CRAB_INLINE constexpr auto end() const {
+      return as_span().end();
+    }
+
+    [[nodiscard]] constexpr auto get_ref_count() const -> usize {
+      assert_valid();
+      return block->strong_count();
+    }
+
+    /**
+     * Returns whether or not this is the only existing reference to the slice.
+     */
+    [[nodiscard]] constexpr auto is_unique() const -> bool {
+      return get_ref_count() == 1;
+    }
+
+    /**
+     * Returns if this instance is in a moved-from state or not, see RcBase::is_valid.
+     */
+    [[nodiscard]] constexpr auto is_valid() const -> bool {
+      return block != nullptr;
+    }
+
+    /**
+     * Returns a copy of this RcSlice
+     */
+    [[nodiscard]] auto clone() const -> RcSlice {
+      return *this;
+    }
+
+    /**
+     * Unsafe factory method that takes over an existing strong reference of the given block.
+     */
+    [[nodiscard]] static constexpr auto from_owned_unchecked(Block* block_ptr) -> RcSlice {
+      return RcSlice{block_ptr};
+    }
+
+  private:
+
+    constexpr auto destroy() -> void {
+      if (block == nullptr) [[unlikely]] {
+        return;
+      }
+
+      if (block->decrement_strong()) {
+        // slices have no weak references, so the block goes with the elements
+        block->drop_value();
+        delete block;
+      }
+
+      block = nullptr;
+    }
+
+    CRAB_INLINE constexpr auto assert_valid(const SourceLocation& loc = SourceLocation::current()) const {
+      crab_check_with_location(is_valid(), loc, "Invalid use of moved-from RcSlice");
+    }
+
+    Block* block;
+  };
+
+  /// Copies every element of the given span into a new shared slice.
+  template<typename T>
+  [[nodiscard]] auto make_rc_slice(const std::span<const T> values) -> RcSlice<T> {
+    return RcSlice<T>::from_owned_unchecked(
+      impl::SliceCounter<T>::allocate(values.size(), [values](const usize i) -> const T& { return values[i]; })
+    );
+  }
+
+  /// Creates a new shared slice of 'length' copies of 'fill'.
+  template<typename T>
+  [[nodiscard]] auto make_rc_slice(const usize length, const T& fill) -> RcSlice<T> {
+    return RcSlice<T>::from_owned_unchecked(
+      impl::SliceCounter<T>::allocate(length, [&fill](usize) -> const T& { return fill; })
+    );
+  }
+}
+
+namespace crab {
+  using ::crab::rc::make_rc_slice;
+
+  namespace prelude {
+    using ::crab::rc::RcSlice;
+  }
+}
+
+CRAB_PRELUDE_GUARD;
+
+// NOLINTEND(*-explicit-constructor)
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "crab/assertion/check.hpp"
+#include "crab/mem/address_of.hpp"
+#include "crab/mem/take.hpp"
+#include "crab/opt/Option.hpp"
+
+#include "crab/rc/impl/Counter.hpp"
+#include "crab/rc/impl/RcStorage.hpp"
+
+namespace crab::rc {
+
+  template<typename T>
+  class Rc;
+
+  /**
+   * Non-owning reference to a resource managed by Rc<T> / RcMut<T>, made with Rc::downgrade.
+   *
+   * A Weak<T> does not keep the resource alive, only the control block. Access to the resource is done through
+   * Weak::upgrade, which gives a new Rc<T> if the resource has not yet been dropped. This is what you want for
+   * back-references (eg. child -> parent) that would otherwise form an Rc cycle and leak.
+   */
+  template<typename T>
+  class Weak final {
+    static_assert(ty::non_const<T>, "Cannot have a Weak of a const T, consider using Weak<T>");
+
+    using Counter = impl::Counter;
+
+    explicit CRAB_INLINE constexpr Weak(const T* data_ptr, Counter* counter_ptr):
+        data{data_ptr}, counter{counter_ptr} {}
+
+  public:
+
+    CRAB_INLINE Weak(const Weak& from): data{from.data}, counter{from.counter} {
+      crab_check(from.is_valid(), "Cannot copy from a moved-from Weak");
+      counter->increment_weak();
+    }
+
+    CRAB_INLINE constexpr Weak(Weak&& from) noexcept: data{mem::take(from.data)}, counter{mem::take(from.counter)} {}
+
+    constexpr auto operator=(const Weak& from) -> Weak& {
+      if (mem::address_of(from) == this) [[unlikely]] {
+        return *this;
+      }
+
+      crab_check(from.is_valid(), "Cannot copy from a moved-from Weak");
+
+      // if we are copying from another weak of the same counter, we can do nothing
+      if (counter == from.counter) [[unlikely]] {
+        return *this;
+      }
+
+      destroy();
+
+      data = from.data;
+      counter = from.counter;
+      counter->increment_weak();
+
+      return *this;
+    }
+
+    constexpr auto operator=(Weak&& from) noexcept -> Weak& {
+      if (mem::address_of(from) == this) [[unlikely]] {
+        return *this;
+      }
+
+      destroy();
+
+      data = mem::take(from.data);
+      counter = mem::take(from.counter);
+
+      return *this;
+    }
+
+    ~Weak() {
+      destroy();
+    }
+
+    /**
+     * Attempts to get a strong reference to the resource, this is None if every strong reference has already been
+     * dropped (and so the resource is gone).
+     */
+    [[nodiscard]] auto upgrade() const -> opt::Option<Rc<T>> {
+      assert_valid();
+
+      if (not counter->try_increment_strong()) {
+        return {};
+      }
+
+      return {Rc<T>::from_owned_unchecked(data, counter)};
+    }
+
+    /**
+     * Returns the number of strong references (Rc / RcMut) to the resource, this is 0 once the resource is dropped.
+     */
+    [[nodiscard]] constexpr auto get_ref_count() const -> usize {
+      assert_valid();
+      return counter->strong_count();
+    }
+
+    /**
+     * Returns the number of weak pointers aiming at the shared resource, including this one.
+     */
+    [[nodiscard]] constexpr auto get_weak_ref_count() const -> usize {
+      assert_valid();
+      return counter->weak_count();
+    }
+
+    /**
+     * Returns whether the resource has been dropped, if so upgrade will always give None.
+     */
+    [[nodiscard]] constexpr auto is_expired() const -> bool {
+      return get_ref_count() == 0;
+    }
+
+    /**
+     * Returns if this instance is in a moved-from state or not, see RcBase::is_valid.
+     */
+    [[nodiscard]] constexpr auto is_valid() const -> bool {
+      return data != nullptr and counter != nullptr;
+    }
+
+    /**
+     * Unsafe factory method that takes over an existing weak reference count of the given counter, the caller is
+     * responsible for having already incremented it.
+     */
+    [[nodiscard]] static constexpr auto from_owned_unchecked(const T* data_ptr, Counter* counter_ptr) -> Weak {
+      return Weak{data_ptr, counter_ptr};
+    }
+
+  private:
+
+    constexpr auto destroy() -> void {
+      if (counter == nullptr) [[unlikely]] {
+        return;
+      }
+
+      // the block outlives the resource only for as long as weak references (or a drop in progress) are observing it
+      if (counter->decrement_weak() and not counter->has_any_strong()) {
+        delete counter;
+      }
+
+      data = nullptr;
+      counter = nullptr;
+    }
+
+    CRAB_INLINE constexpr auto assert_valid(const SourceLocation& loc = SourceLocation::current()) const {
+      crab_check_with_location(is_valid(), loc, "Invalid use of moved-from Weak");
+    }
+
+    const T* data{nullptr};
+    Counter* counter{nullptr};
+  };
+}
+
+namespace crab::prelude {
+  using ::crab::rc::Weak;
+}
+
+CRAB_PRELUDE_GUARD;
@@ -0,0 +1,406 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+
+#include "crab/assertion/check.hpp"
+#include "crab/core/SourceLocation.hpp"
+#include "crab/rc/impl/Counter.hpp"
+
+namespace crab::rc::impl {
+
+  class BiasedCounter;
+
+  /**
+   * Per-thread record for biased reference counting, every BiasedCounter is owned by the thread that created it and
+   * points back to that thread's record.
+   *
+   * When a thread other than the owner drops a reference that was counted by the owner (eg. one that was cloned by the
+   * owner and then moved to another thread), the shared count goes negative and the counter is pushed onto the owner's
+   * merge queue. Only the owner can read its own biased count, so it is the owner who merges the two counts (and drops
+   * the resource if that leaves it unreferenced), either on its next decrement or when the thread exits.
+   *
+   * The record is reference counted by the thread itself and by every counter that points to it, so it may outlive the
+   * thread. Once the thread has exited, the queue is closed and any thread pushing to it merges the counter itself, as
+   * the biased count can no longer change.
+   */
+  class BiasedOwner final {
+  public:
+
+    BiasedOwner() = default;
+
+    BiasedOwner(const BiasedOwner&) = delete;
+
+    BiasedOwner(BiasedOwner&&) = delete;
+
+    auto operator=(const BiasedOwner&) -> BiasedOwner& = delete;
+
+    auto operator=(BiasedOwner&&) -> BiasedOwner& = delete;
+
+    /**
+     * Record for the calling thread, this is nullptr if the thread has never created a biased counter (or has exited).
+     */
+    [[nodiscard]] static CRAB_INLINE auto current_or_null() -> BiasedOwner* {
+      return current;
+    }
+
+    /**
+     * Record for the calling thread, created the first time the thread creates a biased counter.
+     */
+    [[nodiscard]] static auto current_or_create() -> BiasedOwner*;
+
+    CRAB_INLINE auto retain() -> void {
+      refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    CRAB_INLINE auto release() -> void {
+      if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete this;
+      }
+    }
+
+    /**
+     * Whether any counter is waiting for the owner to merge it, only meaningful on the owner thread.
+     */
+    [[nodiscard]] CRAB_INLINE auto has_queued() const -> bool {
+      return queue.load(std::memory_order_relaxed) != nullptr;
+    }
+
+    /**
+     * Whether the owner thread has exited, after which the biased counts of its counters can no longer change.
+     */
+    [[nodiscard]] CRAB_INLINE auto is_closed() const -> bool {
+      return queue.load(std::memory_order_acquire) == closed();
+    }
+
+    /**
+     * Queues the counter for the owner to merge, or merges it immediately if the owner has already exited.
+     */
+    auto push(BiasedCounter* counter) -> void;
+
+    /**
+     * Merges every queued counter, this must only be called by the owner thread.
+     */
+    auto drain() -> void;
+
+  private:
+
+    /// Closes the queue and merges anything left in it, called as the owner thread exits.
+    auto close() -> void;
+
+    /// Sentinel queue head for a closed queue, never dereferenced.
+    [[nodiscard]] static auto closed() -> BiasedCounter* {
+      static constinit char tag{};
+      return reinterpret_cast<BiasedCounter*>(&tag);
+    }
+
+    static auto merge_all(BiasedCounter* head) -> void;
+
+    struct ThreadHandle;
+
+    static inline thread_local BiasedOwner* current{nullptr};
+
+    std::atomic<BiasedCounter*> queue{nullptr};
+    std::atomic_size_t refs{1};
+  };
+
+  /**
+   * Control block for thread-safe reference counting that is biased towards the thread that created the resource
+   * (BiasedArc). Reference count updates from the owner thread are plain loads and stores to a count only it touches,
+   * while every other thread uses an atomic shared count. The two are merged once the owner gives up its last
+   * reference, after which the counter behaves like an AtomicCounter.
+   *
+   * The shared word packs a signed reference count together with two flags: MERGED (the biased count has been folded
+   * in and the owner no longer counts separately) and QUEUED (the counter is waiting in the owner's merge queue, which
+   * keeps it alive until the owner gets to it).
+   *
+   * Weak references are always counted atomically.
+   */
+  class BiasedCounter {
+
+    static constexpr ptrdiff MERGED{1};
+    static constexpr ptrdiff QUEUED{2};
+    static constexpr ptrdiff ONE{4};
+
+    [[nodiscard]] static CRAB_INLINE constexpr auto count_of(const ptrdiff word) -> ptrdiff {
+      return word >> 2;
+    }
+
+  public:
+
+    static constexpr bool IsAtomic = true;
+
+    CRAB_INLINE BiasedCounter(): owner{BiasedOwner::current_or_create()} {
+      owner->retain();
+
+      // a thread that only ever creates resources would otherwise never merge what others queued for it
+      if (owner->has_queued()) [[unlikely]] {
+        owner->drain();
+      }
+    }
+
+    BiasedCounter(const BiasedCounter&) = delete;
+
+    BiasedCounter(BiasedCounter&&) = delete;
+
+    auto operator=(const BiasedCounter&) -> BiasedCounter& = delete;
+
+    auto operator=(BiasedCounter&&) -> BiasedCounter& = delete;
+
+    /**
+     * Deallocates the control block, this never touches the managed resource (see BiasedCounter::drop_value).
+     */
+    virtual ~BiasedCounter() {
+      owner->release();
+    }
+
+    /**
+     * Destroys the managed resource, see BasicCounter::drop_value.
+     */
+    virtual auto drop_value() -> void = 0;
+
+    CRAB_INLINE auto increment_strong() -> void {
+      if (is_biased()) [[likely]] {
+        biased.store(biased.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return;
+      }
+
+      shared.fetch_add(ONE, std::memory_order_relaxed);
+    }
+
+    /**
+     * Decrements the strong reference counter
+     *
+     * Returns whether this leaves the counter at 0
+     */
+    [[nodiscard]] CRAB_INLINE auto decrement_strong(const SourceLocation& loc = SourceLocation::current()) -> bool {
+      if (is_biased()) [[likely]] {
+        crab_dbg_check_with_location(
+          biased.load(std::memory_order_relaxed) != 0,
+          loc,
+          "Counter::decrement should not cause unsigned underflow"
+        );
+
+        return decrement_biased();
+      }
+
+      return decrement_shared();
+    }
+
+    CRAB_INLINE auto increment_weak() -> void {
+      weak.increment();
+    }
+
+    [[nodiscard]] CRAB_INLINE auto decrement_weak(const SourceLocation& loc = SourceLocation::current()) -> bool {
+      crab_dbg_check_with_location(has_any_weak(), loc, "Counter::decrement should not cause unsigned underflow");
+      return weak.decrement();
+    }
+
+    [[nodiscard]] CRAB_INLINE auto has_any_weak() const -> bool {
+      return weak.load() != 0;
+    }
+
+    [[nodiscard]] CRAB_INLINE auto weak_count() const -> usize {
+      return weak.load();
+    }
+
+    [[nodiscard]] CRAB_INLINE auto has_any_strong() const -> bool {
+      return strong_count() != 0;
+    }
+
+    /**
+     * Number of strong references, this is exact from the owner thread, once the counts are merged or once the owner
+     * has exited. From any other thread the owner's biased count can only be estimated, so it is never reported as
+     * unique there.
+     */
+    [[nodiscard]] auto strong_count() const -> usize {
+      const ptrdiff word{shared.load(std::memory_order_acquire)};
+
+      if (is_biased() or owner->is_closed()) {
+        return static_cast<usize>(static_cast<ptrdiff>(biased.load(std::memory_order_relaxed)) + count_of(word));
+      }
+
+      if ((word & MERGED) != 0) {
+        return static_cast<usize>(std::max<ptrdiff>(count_of(word), 0));
+      }
+
+      const ptrdiff estimate{static_cast<ptrdiff>(biased.load(std::memory_order_relaxed)) + count_of(word)};
+      return static_cast<usize>(std::max<ptrdiff>(estimate, 2));
+    }
+
+    /**
+     * Attempts to release the only strong reference without dropping the resource, see BasicCounter. This is
+     * conservative from a thread other than the owner while the counts are not yet merged.
+     */
+    [[nodiscard]] auto try_release_unique() -> bool {
+      if (is_biased()) {
+        if (biased.load(std::memory_order_relaxed) != 1) {
+          return false;
+        }
+
+        // merge with nothing outstanding on the shared side, this leaves the count at 0
+        ptrdiff expected{0};
+        if (not shared.compare_exchange_strong(expected, MERGED, std::memory_order_acq_rel)) {
+          return false;
+        }
+
+        biased.store(0, std::memory_order_relaxed);
+        merged = true;
+        return true;
+      }
+
+      ptrdiff expected{ONE | MERGED};
+      return shared.compare_exchange_strong(expected, MERGED, std::memory_order_acq_rel);
+    }
+
+  private:
+
+    friend class BiasedOwner;
+
+    /// Whether the calling thread updates the biased count, 'merged' is only ever touched by the owner.
+    [[nodiscard]] CRAB_INLINE auto is_biased() const -> bool {
+      return owner == BiasedOwner::current_or_null() and not merged;
+    }
+
+    auto decrement_biased() -> bool {
+      const usize remaining{biased.load(std::memory_order_relaxed) - 1};
+      biased.store(remaining, std::memory_order_relaxed);
+
+      bool unreferenced{false};
+
+      if (remaining == 0) {
+        // the owner has let go, from now on only the shared count matters
+        merged = true;
+        const ptrdiff previous{shared.fetch_or(MERGED, std::memory_order_acq_rel)};
+
+        // if queued, the owner's queue holds on to us and decides when we are unreferenced
+        unreferenced = count_of(previous) == 0 and (previous & QUEUED) == 0;
+      }
+
+      // draining may free this very counter, so nothing past this point touches it
+      if (BiasedOwner* const self{owner}; self->has_queued()) [[unlikely]] {
+        self->drain();
+      }
+
+      return unreferenced;
+    }
+
+    auto decrement_shared() -> bool {
+      ptrdiff word{shared.load(std::memory_order_relaxed)};
+      ptrdiff next{};
+
+      do {
+        next = word - ONE;
+
+        // we dropped a reference that the owner counted, only the owner can tell if that was the last one. This has to
+        // be flagged in the same step, or the owner could merge and free the counter before we get to queue it
+        if ((word & (MERGED | QUEUED)) == 0 and count_of(next) < 0) {
+          next |= QUEUED;
+        }
+      } while (not shared.compare_exchange_weak(word, next, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+      if ((next & MERGED) != 0) {
+        return count_of(next) == 0 and (next & QUEUED) == 0;
+      }
+
+      if ((word & QUEUED) == 0 and (next & QUEUED) != 0) {
+        owner->push(this);
+      }
+
+      return false;
+    }
+
+    /**
+     * Folds the biased count into the shared count and takes this counter out of the queue, dropping the resource if
+     * nothing references it. Runs on the owner thread, or on any thread once the owner has exited.
+     */
+    auto merge_queued() -> void {
+      if (not merged) {
+        const auto remaining{static_cast<ptrdiff>(biased.load(std::memory_order_relaxed))};
+        biased.store(0, std::memory_order_relaxed);
+        merged = true;
+
+        shared.fetch_add(remaining * ONE + MERGED, std::memory_order_acq_rel);
+      }
+
+      if (count_of(shared.fetch_and(~QUEUED, std::memory_order_acq_rel)) == 0) {
+        release();
+      }
+    }
+
+    /// Same as RcBase::drop_resource, for a counter that became unreferenced while queued.
+    auto release() -> void {
+      weak.increment();
+      drop_value();
+
+      if (weak.decrement()) {
+        delete this;
+      }
+    }
+
+    BiasedOwner* const owner;
+    BiasedCounter* queue_next{nullptr};
+    bool merged{false};
+    std::atomic_size_t biased{1};
+    std::atomic<ptrdiff> shared{0};
+    AtomicCount weak{0};
+  };
+
+  /// Releases the calling thread's record as it exits.
+  struct BiasedOwner::ThreadHandle final {
+    BiasedOwner* owner{new BiasedOwner{}};
+
+    ThreadHandle() = default;
+
+    ThreadHandle(const ThreadHandle&) = delete;
+
+    auto operator=(const ThreadHandle&) -> ThreadHandle& = delete;
+
+    ~ThreadHandle() {
+      // anything this thread does from here on (eg. later thread_local destructors) goes through the shared count
+      BiasedOwner::current = nullptr;
+      owner->close();
+      owner->release();
+    }
+  };
+
+  inline auto BiasedOwner::current_or_create() -> BiasedOwner* {
+    if (current == nullptr) [[unlikely]] {
+      static thread_local ThreadHandle handle;
+      current = handle.owner;
+    }
+
+    return current;
+  }
+
+  inline auto BiasedOwner::push(BiasedCounter* const counter) -> void {
+    BiasedCounter* head{queue.load(std::memory_order_acquire)};
+
+    do {
+      if (head == closed()) {
+        // the owner is gone, so its biased count is final and anyone can merge
+        counter->merge_queued();
+        return;
+      }
+
+      counter->queue_next = head;
+    } while (not queue.compare_exchange_weak(head, counter, std::memory_order_release, std::memory_order_acquire));
+  }
+
+  inline auto BiasedOwner::drain() -> void {
+    merge_all(queue.exchange(nullptr, std::memory_order_acquire));
+  }
+
+  inline auto BiasedOwner::close() -> void {
+    merge_all(queue.exchange(closed(), std::memory_order_acq_rel));
+  }
+
+  inline auto BiasedOwner::merge_all(BiasedCounter* head) -> void {
+    while (head != nullptr) {
+      // merging may free the counter, so step past it first
+      BiasedCounter* const next{head->queue_next};
+      head->merge_queued();
+      head = next;
+    }
+  }
+}
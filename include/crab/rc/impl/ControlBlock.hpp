@@ -0,0 +1,183 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+
+#include "crab/core.hpp"
+#include "crab/mem/alloc.hpp"
+#include "crab/mem/forward.hpp"
+#include "crab/rc/impl/Counter.hpp"
+#include "crab/rc/impl/CounterPool.hpp"
+
+namespace crab::rc::impl {
+
+  /**
+   * Control block for a resource that lives in its own, separate heap allocation (eg. one taken from a Box<T> or a raw
+   * owned pointer). The resource is freed with 'delete' once the last strong reference is dropped.
+   *
+   * Single threaded blocks (Rc / RcMut) are allocated from the calling thread's CounterPool rather than the global
+   * allocator, as they are small, all the same size and are created every time an existing allocation is shared.
+   */
+  template<typename T, typename CounterBase = Counter>
+  class PtrCounter final : public CounterBase, public std::conditional_t<CounterBase::IsAtomic, Unpooled, Pooled> {
+  public:
+
+    explicit CRAB_INLINE PtrCounter(T* const owned): owned{owned} {}
+
+    auto drop_value() -> void override {
+      delete owned;
+      owned = nullptr;
+    }
+
+  private:
+
+    T* owned;
+  };
+
+  /**
+   * Control block that stores the resource inline, directly after the counts. This is what make_rc / make_rc_mut use
+   * so that the counter and value are a single heap allocation (and are adjacent in memory).
+   */
+  template<typename T, typename CounterBase = Counter>
+  class InlineCounter final : public CounterBase {
+  public:
+
+    template<typename... Args>
+    explicit CRAB_INLINE InlineCounter(Args&&... args) {
+      std::construct_at<T, Args...>(reinterpret_cast<T*>(bytes.data()), mem::forward<Args>(args)...);
+    }
+
+    auto drop_value() -> void override {
+      std::destroy_at(value_ptr());
+    }
+
+    /**
+     * Pointer to the inline resource, this is only valid to dereference while the strong count is non-zero.
+     */
+    [[nodiscard]] CRAB_INLINE CRAB_RETURNS_NONNULL auto value_ptr() -> T* {
+      return std::launder(reinterpret_cast<T*>(bytes.data()));
+    }
+
+  private:
+
+    alignas(T) std::array<std::byte, sizeof(T)> bytes;
+  };
+
+  /**
+   * Same as InlineCounter, but the block is allocated with (and keeps a copy of) a user given standard allocator, this
+   * is what make_rc_in / make_rc_mut_in use. A stateless allocator adds nothing to the size of the block.
+   *
+   * Handles never know which allocator their block came from, the block frees itself with a destroying delete so that
+   * it can take its allocator out before it is destroyed.
+   */
+  template<typename T, typename CounterBase, mem::allocator Alloc>
+  class AllocInlineCounter final : public CounterBase {
+    static_assert(not std::same_as<Alloc, mem::Global>, "Use InlineCounter for the global allocator");
+
+  public:
+
+    /**
+     * Allocates a block with the given allocator, constructing the resource inside of it from 'args'.
+     */
+    template<typename... Args>
+    [[nodiscard]] static auto allocate(Alloc alloc, Args&&... args) -> AllocInlineCounter* {
+      return mem::alloc_new<AllocInlineCounter>(alloc, alloc, mem::forward<Args>(args)...);
+    }
+
+    template<typename... Args>
+    explicit CRAB_INLINE AllocInlineCounter(const Alloc& alloc, Args&&... args): alloc{alloc} {
+      std::construct_at<T, Args...>(reinterpret_cast<T*>(bytes.data()), mem::forward<Args>(args)...);
+    }
+
+    /**
+     * Destroys the block and gives its memory back to the allocator it was made with, this is picked by the virtual
+     * destructor when the block is deleted through a pointer to the base counter.
+     */
+    static auto operator delete(AllocInlineCounter* const block, std::destroying_delete_t) -> void {
+      Alloc alloc{mem::move(block->alloc)};
+      mem::alloc_delete(alloc, block);
+    }
+
+    auto drop_value() -> void override {
+      std::destroy_at(value_ptr());
+    }
+
+    /**
+     * Pointer to the inline resource, this is only valid to dereference while the strong count is non-zero.
+     */
+    [[nodiscard]] CRAB_INLINE CRAB_RETURNS_NONNULL auto value_ptr() -> T* {
+      return std::launder(reinterpret_cast<T*>(bytes.data()));
+    }
+
+  private:
+
+    CRAB_NO_UNIQUE_ADDRESS Alloc alloc;
+    alignas(T) std::array<std::byte, sizeof(T)> bytes;
+  };
+
+  /**
+   * Control block for a shared slice (RcSlice<T>), the length and elements are stored inline directly after the counts
+   * so that the whole slice is a single heap allocation. Because the size of the block depends on the length, it can
+   * only be created through SliceCounter::allocate.
+   */
+  template<typename T, typename CounterBase = Counter>
+  class alignas(CounterBase) alignas(T) SliceCounter final : public CounterBase {
+
+    explicit CRAB_INLINE SliceCounter(const usize length): length{length} {}
+
+  public:
+
+    /**
+     * Allocates a block for 'length' elements, and constructs each one with 'init(index)'.
+     */
+    template<typename F>
+    [[nodiscard]] static auto allocate(const usize length, F&& init) -> SliceCounter* {
+      void* const raw{::operator new(sizeof(SliceCounter) + length * sizeof(T), std::align_val_t{alignof(SliceCounter)})};
+
+      auto* const block{::new (raw) SliceCounter{length}};
+
+      T* const elements{block->storage()};
+      for (usize i = 0; i < length; i++) {
+        std::construct_at(elements + i, init(i));
+      }
+
+      return block;
+    }
+
+    /**
+     * Frees the whole block (including the trailing elements), this is picked by the virtual destructor when the block
+     * is deleted through a pointer to the base counter.
+     */
+    static auto operator delete(void* const raw) -> void {
+      ::operator delete(raw, std::align_val_t{alignof(SliceCounter)});
+    }
+
+    auto drop_value() -> void override {
+      std::destroy_n(elements(), length);
+    }
+
+    /**
+     * Pointer to the first inline element, this is only valid to dereference while the strong count is non-zero.
+     */
+    [[nodiscard]] CRAB_INLINE CRAB_RETURNS_NONNULL auto elements() -> T* {
+      return std::launder(storage());
+    }
+
+    [[nodiscard]] CRAB_INLINE auto as_span() -> std::span<T> {
+      return {elements(), length};
+    }
+
+  private:
+
+    [[nodiscard]] CRAB_INLINE auto storage() -> T* {
+      return reinterpret_cast<T*>(reinterpret_cast<std::byte*>(this) + sizeof(SliceCounter));
+    }
+
+    usize length;
+  };
+
+}
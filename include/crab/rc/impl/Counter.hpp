@@ -7,35 +7,177 @@
 #include <atomic>
 
 namespace crab::rc::impl {
-  class Counter final {
 
+  /**
+   * Counting policy for reference counts that are only ever touched by a single thread (Rc / RcMut).
+   */
+  class LocalCount final {
   public:
 
-    explicit CRAB_INLINE Counter(const usize strong_count = 1, const usize weak_count = 0):
+    static constexpr bool IsAtomic = false;
+
+    explicit CRAB_INLINE constexpr LocalCount(const usize count): count{count} {}
+
+    [[nodiscard]] CRAB_INLINE constexpr auto load() const -> usize {
+      return count;
+    }
+
+    CRAB_INLINE constexpr auto increment() -> void {
+      count++;
+    }
+
+    /**
+     * Decrements the count, returns whether this leaves the count at 0
+     */
+    [[nodiscard]] CRAB_INLINE constexpr auto decrement() -> bool {
+      count--;
+      return count == 0;
+    }
+
+    /**
+     * Increments the count only if it is not already 0, returns whether the increment took place.
+     */
+    [[nodiscard]] CRAB_INLINE constexpr auto increment_if_nonzero() -> bool {
+      if (count == 0) {
+        return false;
+      }
+
+      count++;
+      return true;
+    }
+
+    /**
+     * Sets the count to 'desired' only if it is currently 'expected', returns whether the exchange took place.
+     */
+    [[nodiscard]] CRAB_INLINE constexpr auto exchange_if(const usize expected, const usize desired) -> bool {
+      if (count != expected) {
+        return false;
+      }
+
+      count = desired;
+      return true;
+    }
+
+  private:
+
+    usize count;
+  };
+
+  /**
+   * Counting policy for reference counts that are shared between threads (Arc / ArcMut).
+   *
+   * Increments are relaxed, as a new reference can only be made from an existing one (which already keeps the
+   * resource alive). Decrements are acquire-release, so that every other thread's use of the resource happens-before the
+   * thread that brings the count to zero drops it.
+   */
+  class AtomicCount final {
+  public:
+
+    static constexpr bool IsAtomic = true;
+
+    explicit CRAB_INLINE AtomicCount(const usize count): count{count} {}
+
+    [[nodiscard]] CRAB_INLINE auto load() const -> usize {
+      return count.load(std::memory_order_acquire);
+    }
+
+    CRAB_INLINE auto increment() -> void {
+      count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * Decrements the count, returns whether this leaves the count at 0
+     */
+    [[nodiscard]] CRAB_INLINE auto decrement() -> bool {
+      // acq_rel rather than release + an acquire fence on zero, as thread sanitizers do not model standalone fences
+      return count.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
+
+    /**
+     * Increments the count only if it is not already 0, returns whether the increment took place.
+     */
+    [[nodiscard]] CRAB_INLINE auto increment_if_nonzero() -> bool {
+      usize current{count.load(std::memory_order_relaxed)};
+
+      while (current != 0) {
+        if (count.compare_exchange_weak(current, current + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    /**
+     * Sets the count to 'desired' only if it is currently 'expected', returns whether the exchange took place.
+     */
+    [[nodiscard]] CRAB_INLINE auto exchange_if(usize expected, const usize desired) -> bool {
+      return count.compare_exchange_strong(expected, desired, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+  private:
+
+    std::atomic_size_t count;
+  };
+
+  /**
+   * Reference counting control block shared between all Rc/RcMut (or Arc/ArcMut) instances pointing at the same
+   * resource, 'Count' is the counting policy used for both the strong and weak counts (LocalCount or AtomicCount).
+   *
+   * The counter itself does not know the type of the resource it manages, that is left to the derived control blocks
+   * (see ControlBlock.hpp) which decide how the resource is dropped and how the block itself is deallocated.
+   */
+  template<typename Count>
+  class BasicCounter {
+
+  public:
+
+    static constexpr bool IsAtomic = Count::IsAtomic;
+
+    explicit CRAB_INLINE BasicCounter(const usize strong_count = 1, const usize weak_count = 0):
         strong{strong_count}, weak{weak_count} {}
 
+    BasicCounter(const BasicCounter&) = delete;
+
+    BasicCounter(BasicCounter&&) = delete;
+
+    auto operator=(const BasicCounter&) -> BasicCounter& = delete;
+
+    auto operator=(BasicCounter&&) -> BasicCounter& = delete;
+
+    /**
+     * Deallocates the control block, this never touches the managed resource (see BasicCounter::drop_value).
+     */
+    virtual ~BasicCounter() = default;
+
+    /**
+     * Destroys the managed resource, this is called exactly once when the strong count reaches zero. The control block
+     * itself must remain valid after this call for as long as there are any weak references.
+     */
+    virtual auto drop_value() -> void = 0;
+
     constexpr CRAB_INLINE auto increment_strong() -> void {
-      strong++;
+      strong.increment();
     }
 
     constexpr CRAB_INLINE auto increment_weak() -> void {
-      weak++;
+      weak.increment();
     }
 
     [[nodiscard]] constexpr CRAB_INLINE auto has_any_strong() const -> bool {
-      return strong != 0;
+      return strong.load() != 0;
     }
 
     [[nodiscard]] constexpr CRAB_INLINE auto has_any_weak() const -> bool {
-      return weak != 0;
+      return weak.load() != 0;
     }
 
     [[nodiscard]] constexpr CRAB_INLINE auto strong_count() const -> usize {
-      return strong;
+      return strong.load();
     }
 
     [[nodiscard]] constexpr CRAB_INLINE auto weak_count() const -> usize {
-      return weak;
+      return weak.load();
     }
 
     /**
@@ -45,11 +187,9 @@ namespace crab::rc::impl {
      */
     [[nodiscard]]
     constexpr CRAB_INLINE auto decrement_strong(const SourceLocation& loc = SourceLocation::current()) -> bool {
-      crab_dbg_check_with_location(strong != 0, loc, "Counter::decrement should not cause unsigned underflow");
-
-      strong--;
+      crab_dbg_check_with_location(has_any_strong(), loc, "Counter::decrement should not cause unsigned underflow");
 
-      return strong == 0;
+      return strong.decrement();
     }
 
     /**
@@ -59,17 +199,40 @@ namespace crab::rc::impl {
      */
     [[nodiscard]]
     constexpr CRAB_INLINE auto decrement_weak(const SourceLocation& loc = SourceLocation::current()) -> bool {
-      crab_dbg_check_with_location(strong != 0, loc, "Counter::decrement should not cause unsigned underflow");
+      crab_dbg_check_with_location(has_any_weak(), loc, "Counter::decrement should not cause unsigned underflow");
 
-      weak--;
+      return weak.decrement();
+    }
 
-      return weak == 0;
+    /**
+     * Creates a new strong reference only if the resource has not already been dropped, this is how a weak reference
+     * is upgraded.
+     *
+     * Returns whether a strong reference was made
+     */
+    [[nodiscard]] constexpr CRAB_INLINE auto try_increment_strong() -> bool {
+      return strong.increment_if_nonzero();
+    }
+
+    /**
+     * Attempts to release the only strong reference without dropping the resource, this is used to move the resource
+     * out of a uniquely owned control block.
+     *
+     * Returns whether the strong count was exactly 1 (and is now 0)
+     */
+    [[nodiscard]] constexpr CRAB_INLINE auto try_release_unique() -> bool {
+      return strong.exchange_if(1, 0);
     }
 
   private:
 
-    static constexpr bool IsAtomic = false;
-    ty::conditional<IsAtomic, std::atomic_size_t, usize> strong{}, weak{};
+    Count strong, weak;
   };
 
+  /// Control block for single threaded reference counting (Rc / RcMut)
+  using Counter = BasicCounter<LocalCount>;
+
+  /// Control block for thread-safe reference counting (Arc / ArcMut)
+  using AtomicCounter = BasicCounter<AtomicCount>;
+
 }
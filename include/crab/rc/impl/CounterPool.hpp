@@ -0,0 +1,33 @@
+#pragma once
+
+#include "crab/core.hpp"
+#include "crab/mem/impl/BlockPool.hpp"
+#include "crab/num/integer.hpp"
+
+namespace crab::rc::impl {
+
+  /**
+   * Thread-local pool for small control blocks, used by PtrCounter for Rc / RcMut so that wrapping an existing
+   * allocation (eg. Rc<T>{Box<T>}) does not go through the global allocator for its counter every time.
+   */
+  using CounterPool = mem::impl::BlockPool<16, 4, 256>;
+
+  /**
+   * Base for a control block that is allocated from the calling thread's CounterPool.
+   */
+  struct Pooled {
+    [[nodiscard]] static CRAB_INLINE auto operator new(const usize size) -> void* {
+      return CounterPool::allocate(size);
+    }
+
+    static CRAB_INLINE auto operator delete(void* const raw, const usize size) -> void {
+      CounterPool::deallocate(raw, size);
+    }
+  };
+
+  /**
+   * Base for a control block that is allocated from the global allocator, the counterpart to Pooled.
+   */
+  struct Unpooled {};
+
+}
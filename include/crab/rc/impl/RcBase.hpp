@@ -2,19 +2,27 @@
 #pragma once
 
 #include "Counter.hpp"
+#include "ControlBlock.hpp"
 #include "crab/assertion/check.hpp"
+#include "crab/boxed/Box.hpp"
 #include "crab/mem/address_of.hpp"
 #include "crab/mem/take.hpp"
 #include "crab/opt/Option.hpp"
+#include "crab/ref/type_id.hpp"
+#include "crab/result/forward.hpp"
 
 namespace crab::rc::impl {
-  template<typename T, template<typename> class Self>
+  /**
+   * Shared implementation of Rc/RcMut & Arc/ArcMut, 'C' is the type of control block used (which determines whether
+   * reference counts are atomic).
+   */
+  template<typename T, template<typename> class Self, typename C = impl::Counter>
   class RcBase {
     static_assert(ty::non_reference<T>, "Cannot allocate data for a reference type (T& / const T&)");
 
   public:
 
-    using Counter = impl::Counter;
+    using Counter = C;
     using TMut = std::remove_const_t<T>;
     using TConst = std::add_const_t<TMut>;
 
@@ -32,15 +40,29 @@ namespace crab::rc::impl {
 
       crab_check(data != nullptr, "No data paired with counter");
 
-      // if decrementing the strong counter leaves it 0 and the counter has 0 weak references, delete it
-      if (counter->decrement_strong() and not counter->has_any_weak()) {
-        delete counter;
+      if (counter->decrement_strong()) {
+        drop_resource();
       }
 
       data = nullptr;
       counter = nullptr;
     }
 
+    /**
+     * Drops the resource once the last strong reference is gone, the control block itself is only freed once there
+     * are no weak references left to observe it.
+     */
+    auto drop_resource() -> void {
+      // the strong references collectively hold an implicit weak reference while dropping, so that the resource's
+      // destructor dropping the last weak reference to itself does not free the block out from under us
+      counter->increment_weak();
+      counter->drop_value();
+
+      if (counter->decrement_weak()) {
+        delete counter;
+      }
+    }
+
   public:
 
     RcBase(const RcBase& from): data{from.data}, counter{from.counter} {
@@ -162,6 +184,97 @@ namespace crab::rc::impl {
       return data != nullptr and counter != nullptr;
     }
 
+    /**
+     * Converts this into a Box<T> if this is the only strong reference to the resource, this moves the value into a new
+     * allocation. If the resource is shared then ownership is given back unchanged as the error.
+     *
+     * Note that this moves the value as its static type T, calling this on an upcasted reference will slice the value.
+     */
+    [[nodiscard]] auto into_box() && -> result::Result<boxed::Box<TMut>, Self<TMut>> requires ty::movable<TMut>
+    {
+      assert_valid();
+
+      if (not counter->try_release_unique()) {
+        return result::Err<Self<TMut>>{
+          Self<TMut>::from_owned_unchecked(mem::take(data), mem::take(counter)),
+        };
+      }
+
+      return result::Ok<boxed::Box<TMut>>{boxed::make_box<TMut>(take_released_value())};
+    }
+
+    /**
+     * Moves the value out if this is the only strong reference to the resource, without copying it. If the resource is
+     * shared then ownership is given back unchanged as the error. Any weak references are left expired.
+     *
+     * Note that this moves the value as its static type T, calling this on an upcasted reference will slice the value.
+     */
+    [[nodiscard]] auto try_unwrap() && -> result::Result<TMut, Self<TMut>> requires ty::movable<TMut>
+    {
+      assert_valid();
+
+      if (not counter->try_release_unique()) {
+        return result::Err<Self<TMut>>{
+          Self<TMut>::from_owned_unchecked(mem::take(data), mem::take(counter)),
+        };
+      }
+
+      return result::Ok<TMut>{take_released_value()};
+    }
+
+    /**
+     * Drops this reference, moving the value out if it was the last strong reference to the resource. Unlike
+     * try_unwrap, this never gives ownership back, so of many references calling into_inner exactly one will get the
+     * value.
+     */
+    [[nodiscard]] auto into_inner() && -> opt::Option<TMut> requires ty::movable<TMut>
+    {
+      assert_valid();
+
+      if (not counter->decrement_strong()) {
+        data = nullptr;
+        counter = nullptr;
+        return {};
+      }
+
+      return {take_released_value()};
+    }
+
+    /**
+     * Gets a mutable reference to the value, copying it into a new allocation first if it is shared (clone-on-write).
+     *
+     * If this is the only reference then the value is mutated in place, and if the only other references are weak then
+     * the value is moved (not copied) into a new allocation, leaving those weak references expired.
+     *
+     * Note that a copy is made as the static type T, calling this on an upcasted reference will slice the value.
+     */
+    [[nodiscard]] auto make_mut() -> TMut& requires ty::copy_constructible<TMut>
+    {
+      assert_valid();
+
+      if (counter->strong_count() == 1 and not counter->has_any_weak()) {
+        // SAFETY: every control block constructs its value as non-const, and no one else can observe it
+        return *const_cast<TMut*>(data);
+      }
+
+      if (counter->try_release_unique()) {
+        // SAFETY: we were the only strong reference, so no one else can observe the value being moved out
+        auto* const block{new InlineCounter<TMut, Counter>{mem::move(*const_cast<TMut*>(data))}};
+        drop_resource();
+
+        data = block->value_ptr();
+        counter = block;
+        return *block->value_ptr();
+      }
+
+      auto* const block{new InlineCounter<TMut, Counter>{*data}};
+      destroy();
+
+      data = block->value_ptr();
+      counter = block;
+      return *block->value_ptr();
+    }
+
     template<typename U>
     requires ty::non_const<U> and std::derived_from<T, U>
     [[nodiscard]] auto upcast() const& -> Self<U> {
@@ -189,7 +302,7 @@ namespace crab::rc::impl {
     [[nodiscard]] auto downcast() && -> opt::Option<Self<U>> {
       assert_valid();
 
-      auto* casted = dynamic_cast<ty::conditional<ty::is_const<T>, const U, U>*>(data);
+      auto* casted = ref::dynamic_downcast<U>(data);
 
       if (casted == nullptr) {
         return {};
@@ -202,6 +315,22 @@ namespace crab::rc::impl {
 
   protected:
 
+    /**
+     * Moves the value out of a control block whose strong count has already been released to 0, then drops what is
+     * left of the resource. This leaves this instance in a moved-from state.
+     */
+    [[nodiscard]] auto take_released_value() -> TMut {
+      // SAFETY: there are no strong references left, so no one else can observe the value being moved out
+      TMut value{mem::move(*const_cast<TMut*>(data))};
+
+      drop_resource();
+
+      data = nullptr;
+      counter = nullptr;
+
+      return value;
+    }
+
     CRAB_INLINE constexpr auto assert_valid(const SourceLocation& loc = SourceLocation::current()) const {
       crab_check_with_location(
         is_valid(),
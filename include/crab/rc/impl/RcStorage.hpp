@@ -14,20 +14,37 @@ namespace crab {
     template<typename T>
     class RcMut;
 
+    template<typename T>
+    class Weak;
+
+    template<typename T>
+    class RcSlice;
+
+    template<typename T>
+    class IntrusiveRc;
+
+    template<typename T>
+    class Arc;
+
+    template<typename T>
+    class ArcMut;
+
+    template<typename T>
+    class BiasedArc;
+
     namespace impl {
       template<typename RefCounted>
       struct RcStorage final {
 
         CRAB_INLINE constexpr explicit RcStorage(RefCounted value): inner{mem::move(value)} {}
 
-        CRAB_INLINE constexpr explicit RcStorage(const opt::None& = {}):
-            inner{RefCounted::from_owned_unchecked(nullptr, nullptr)} {}
+        CRAB_INLINE constexpr explicit RcStorage(const opt::None& = {}): inner{invalid()} {}
 
         CRAB_INLINE constexpr RcStorage(const RcStorage& storage):
-            inner{storage.in_use() ? storage.inner : RefCounted::from_owned_unchecked(nullptr, nullptr)} {}
+            inner{storage.in_use() ? storage.inner : invalid()} {}
 
         CRAB_INLINE constexpr RcStorage(RcStorage&& storage) noexcept:
-            inner{storage.in_use() ? storage.inner : RefCounted::from_owned_unchecked(nullptr, nullptr)} {}
+            inner{storage.in_use() ? storage.inner : invalid()} {}
 
         CRAB_INLINE constexpr auto operator=(const RcStorage& value) -> RcStorage& {
           if (&value == this) [[unlikely]] {
@@ -87,6 +104,16 @@ namespace crab {
 
       private:
 
+        /// The moved-from state of RefCounted, used as the niche for none.
+        [[nodiscard]] CRAB_INLINE static constexpr auto invalid() -> RefCounted {
+          if constexpr (requires { RefCounted::from_owned_unchecked(nullptr, nullptr); }) {
+            return RefCounted::from_owned_unchecked(nullptr, nullptr);
+          } else {
+            // single pointer types (eg. RcSlice, IntrusiveRc) only have the one pointer
+            return RefCounted::from_owned_unchecked(nullptr);
+          }
+        }
+
         RefCounted inner;
       };
     }
@@ -105,5 +132,35 @@ namespace crab {
     struct Storage<rc::RcMut<T>> final {
       using type = rc::impl::RcStorage<rc::RcMut<T>>;
     };
+
+    template<typename T>
+    struct Storage<rc::Weak<T>> final {
+      using type = rc::impl::RcStorage<rc::Weak<T>>;
+    };
+
+    template<typename T>
+    struct Storage<rc::RcSlice<T>> final {
+      using type = rc::impl::RcStorage<rc::RcSlice<T>>;
+    };
+
+    template<typename T>
+    struct Storage<rc::IntrusiveRc<T>> final {
+      using type = rc::impl::RcStorage<rc::IntrusiveRc<T>>;
+    };
+
+    template<typename T>
+    struct Storage<rc::Arc<T>> final {
+      using type = rc::impl::RcStorage<rc::Arc<T>>;
+    };
+
+    template<typename T>
+    struct Storage<rc::ArcMut<T>> final {
+      using type = rc::impl::RcStorage<rc::ArcMut<T>>;
+    };
+
+    template<typename T>
+    struct Storage<rc::BiasedArc<T>> final {
+      using type = rc::impl::RcStorage<rc::BiasedArc<T>>;
+    };
   }
 }
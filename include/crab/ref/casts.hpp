@@ -9,23 +9,25 @@
 
 #include "crab/ref/from_ptr.hpp"
 #include "crab/ref/ref.hpp"
+#include "crab/ref/type_id.hpp"
 
 namespace crab::ref {
   /// @addtogroup ref
   /// @{
 
-  // Attempts to cast input of type Base into a Derived instance
+  /// Attempts to cast input of type Base into a Derived instance, this is an integer comparison rather than a
+  /// dynamic_cast if the hierarchy is type identified (see TypeRange).
   template<class Derived, typename Base>
   [[nodiscard]] CRAB_INLINE constexpr auto cast(const Base* from) -> opt::Option<const Derived&> {
     static_assert(std::derived_from<Derived, Base>);
-    return from_ptr(dynamic_cast<const Derived*>(from));
+    return from_ptr(dynamic_downcast<const Derived>(from));
   }
 
   /// @copydoc crab::ref::cast
   template<class Derived, typename Base>
   [[nodiscard]] CRAB_INLINE constexpr auto cast(Base* from) -> opt::Option<Derived&> {
     static_assert(std::derived_from<Derived, Base>);
-    return from_ptr(dynamic_cast<Derived*>(from));
+    return from_ptr(dynamic_downcast<Derived>(from));
   }
 
   /// @copydoc crab::ref::cast
@@ -6,6 +6,7 @@
 #include <concepts>
 #include "crab/core.hpp"
 #include "crab/mem/address_of.hpp"
+#include "crab/ref/type_id.hpp"
 
 namespace crab::ref {
 
@@ -16,8 +17,13 @@ namespace crab::ref {
   /// @param obj Object to check
   /// @returns whether or not the object is of the given type
   /// @ingroup ref
-  template<class Derived, std::derived_from<Derived> Base>
+  template<class Derived, class Base>
+  requires std::derived_from<Base, Derived> or std::derived_from<Derived, Base>
   [[nodiscard]] CRAB_INLINE constexpr auto is(const Base& obj) noexcept -> bool {
-    return dynamic_cast<const Derived*>(mem::address_of(obj)) != nullptr;
+    if constexpr (std::derived_from<Base, Derived>) {
+      return true;
+    } else {
+      return dynamic_downcast<const Derived>(mem::address_of(obj)) != nullptr;
+    }
   }
 }
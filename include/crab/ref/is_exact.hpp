@@ -3,8 +3,10 @@
 
 #pragma once
 
+#include <type_traits>
 #include <typeinfo>
 #include "crab/core.hpp"
+#include "crab/ref/type_id.hpp"
 
 namespace crab::ref {
 
@@ -14,6 +16,8 @@ namespace crab::ref {
   ///
   /// This will not perform a recursive check like dynamic_cast. This symbol is also exposed as simply crab::is_exact
   ///
+  /// For a type identified hierarchy (see TypeRange) this compares type ids rather than using typeid.
+  ///
   /// # Examples
   ///
   /// ```cpp
@@ -36,7 +40,18 @@ namespace crab::ref {
   /// ```
   template<typename T>
   [[nodiscard]] CRAB_INLINE constexpr auto is_exact([[maybe_unused]] const auto& obj) noexcept -> bool {
-    return typeid(obj) == typeid(T);
+    using Base = std::remove_cvref_t<decltype(obj)>;
+
+    if constexpr (fast_castable<T, Base>) {
+      return obj.crab_type_id() == T::crab_type_range.first;
+    } else {
+#if CRAB_RTTI
+      return typeid(obj) == typeid(T);
+#else
+      static_assert(fast_castable<T, Base>, "is_exact without RTTI requires a type identified hierarchy (see TypeRange)");
+      return false;
+#endif
+    }
   }
 }
 
@@ -0,0 +1,134 @@
+/// @file crab/ref/type_id.hpp
+/// @ingroup ref
+/// Opt-in type identity for class hierarchies, used to downcast without RTTI
+
+#pragma once
+
+#include <concepts>
+#include <type_traits>
+
+#include "crab/core.hpp"
+#include "crab/num/integer.hpp"
+
+namespace crab::ref {
+  /// @addtogroup ref
+  /// @{
+
+  /// Numeric identity of a class inside of a type identified hierarchy, see TypeRange.
+  using TypeId = u32;
+
+  /// Range of type ids that belong to the class T, its own id along with the ids of every class derived from it.
+  ///
+  /// A hierarchy opts into fast downcasting by numbering its classes in pre-order (a class is given an id before any of
+  /// its children, and all of its descendants are numbered before its siblings), so that every class's descendants
+  /// form a contiguous range that starts at its own id. Each class declares that range as `crab_type_range`, and the
+  /// root of the hierarchy stores the id of the most derived class (see TypeTag). Downcasting through `ref::cast`,
+  /// `Box::downcast`, `Rc::downcast` (and so on) is then a range check on an integer instead of a dynamic_cast.
+  ///
+  /// Every class that is downcast to must declare its own range, the class parameter is there to catch one that is
+  /// inherited by mistake.
+  ///
+  /// # Examples
+  /// ```cpp
+  /// struct Shape : crab::ref::TypeTag {
+  ///   static constexpr crab::ref::TypeRange<Shape> crab_type_range{0, 2};
+  ///   using TypeTag::TypeTag;
+  /// };
+  ///
+  /// struct Circle final : Shape {
+  ///   static constexpr crab::ref::TypeRange<Circle> crab_type_range{1, 1};
+  ///   Circle(): Shape{crab_type_range.first} {}
+  /// };
+  ///
+  /// struct Square final : Shape {
+  ///   static constexpr crab::ref::TypeRange<Square> crab_type_range{2, 2};
+  ///   Square(): Shape{crab_type_range.first} {}
+  /// };
+  ///
+  /// Box<Shape> shape{crab::make_box<Circle>()};
+  /// crab_check(shape.downcast<Circle>().is_some());
+  /// ```
+  template<typename T>
+  struct TypeRange final {
+    /// Id of T itself
+    TypeId first;
+
+    /// Last id (inclusive) of a class derived from T
+    TypeId last;
+
+    /// Whether the given id is T or one of its descendants
+    [[nodiscard]] CRAB_INLINE constexpr auto contains(const TypeId id) const -> bool {
+      // a single comparison, ids below 'first' wrap around to be larger than the range
+      return id - first <= last - first;
+    }
+  };
+
+  /// Base for the root of a type identified hierarchy, this stores the id of the most derived class which every
+  /// constructor passes along.
+  class TypeTag {
+    TypeId id;
+
+  protected:
+
+    CRAB_INLINE constexpr explicit TypeTag(const TypeId id): id{id} {}
+
+  public:
+
+    /// Type id of the most derived class of this object
+    [[nodiscard]] CRAB_INLINE constexpr auto crab_type_id() const -> TypeId {
+      return id;
+    }
+  };
+
+  /// Whether T declares its own range of type ids
+  template<typename T>
+  concept type_identified = requires {
+    { T::crab_type_range } -> std::same_as<const TypeRange<T>&>;
+  };
+
+  /// Whether a pointer to Base can be downcast to Derived by checking its type id rather than with dynamic_cast
+  template<typename Derived, typename Base>
+  concept fast_castable = type_identified<Derived> and requires(const Base& base, Base* ptr) {
+    { base.crab_type_id() } -> std::same_as<TypeId>;
+    static_cast<Derived*>(ptr);
+  };
+
+  /// Casts a pointer to Base into a pointer to Derived, or nullptr if it does not point to a Derived. This is an
+  /// integer range check for hierarchies that opt in (see TypeRange), and dynamic_cast for any other.
+  template<typename Derived, typename Base>
+  requires std::derived_from<std::remove_const_t<Derived>, std::remove_const_t<Base>>
+  [[nodiscard]] CRAB_INLINE constexpr auto dynamic_downcast(Base* const from)
+    -> std::conditional_t<std::is_const_v<Base>, const Derived, Derived>* {
+    using D = std::conditional_t<std::is_const_v<Base>, const Derived, Derived>;
+    using Target = std::remove_const_t<Derived>;
+
+    if constexpr (fast_castable<Target, std::remove_const_t<Base>>) {
+      if constexpr (type_identified<std::remove_const_t<Base>>) {
+        constexpr auto range{Target::crab_type_range};
+        constexpr auto base{std::remove_const_t<Base>::crab_type_range};
+        static_assert(
+          base.first <= range.first and range.last <= base.last,
+          "The type range of a derived class must lie within the range of its base"
+        );
+      }
+
+      if (from == nullptr or not Target::crab_type_range.contains(from->crab_type_id())) {
+        return nullptr;
+      }
+
+      return static_cast<D*>(from);
+    } else {
+#if CRAB_RTTI
+      return dynamic_cast<D*>(from);
+#else
+      static_assert(
+        fast_castable<Target, std::remove_const_t<Base>>,
+        "Downcasting without RTTI requires a type identified hierarchy (see TypeRange)"
+      );
+      return nullptr;
+#endif
+    }
+  }
+
+  /// }@
+}
@@ -0,0 +1,189 @@
+/// @file crab/result/AnyError.hpp
+/// @ingroup result
+///
+/// Type erased error that stores small errors inline, an alternative to Result<T, Box<IError>>.
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+
+#include "crab/assertion/fmt.hpp"
+#include "crab/boxed/Box.hpp"
+#include "crab/boxed/InlineBox.hpp"
+#include "crab/core.hpp"
+#include "crab/mem/forward.hpp"
+#include "crab/mem/move.hpp"
+#include "crab/num/integer.hpp"
+#include "crab/opt/Option.hpp"
+#include "crab/opt/niche.hpp"
+#include "crab/result/Error.hpp"
+#include "crab/result/ErrorCode.hpp"
+#include "crab/str/str.hpp"
+
+namespace crab::result {
+
+  /// Owned error of any type derived from IError, which is stored inline if it fits in AnyError::Capacity bytes (and
+  /// on the heap otherwise). This lets a Result carry any error without an allocation per error, as
+  /// Result<T, Box<IError>> needs.
+  ///
+  /// An ErrorCode can also be held (as an IError), which always fits inline.
+  ///
+  /// AnyError has a niche (see opt::Niche), so Option<AnyError> is the same size as AnyError. As it is not trivially
+  /// copyable, a Result<T, AnyError> keeps a separate tag. Like InlineBox, a moved-from AnyError is only safe to
+  /// reassign or destroy.
+  ///
+  /// # Examples
+  /// ```cpp
+  /// struct Timeout final : crab::IError {
+  ///   u32 millis;
+  ///
+  ///   explicit Timeout(u32 millis): millis{millis} {}
+  ///
+  ///   auto what() const -> String override { return fmt::format("timed out after {}ms", millis); }
+  /// };
+  ///
+  /// auto call() -> Result<u32, AnyError> {
+  ///   return crab::make_any_error<Timeout>(500);
+  /// }
+  ///
+  /// if (Option<const Timeout&> timeout{call().get_err().downcast<Timeout>()}) { ... }
+  /// ```
+  /// @ingroup result
+  class AnyError final {
+  public:
+
+    /// Size in bytes of the largest error stored inline
+    static constexpr usize Capacity{32};
+
+    /// Box that the error is held in
+    using Storage = boxed::InlineBox<IError, Capacity, alignof(void*)>;
+
+    /// Whether an error of type E is stored inline, rather than on the heap
+    template<std::derived_from<IError> E>
+    static constexpr bool fits_inline{Storage::fits_inline<E>};
+
+    /// Constructs an E from the given arguments, inline if it fits
+    template<std::derived_from<IError> E, typename... Args>
+    requires std::constructible_from<E, Args...>
+    [[nodiscard]] CRAB_INLINE static auto make(Args&&... args) -> AnyError {
+      return AnyError{Storage::make<E>(mem::forward<Args>(args)...)};
+    }
+
+    /// Holds the given error, inline if it fits
+    template<std::derived_from<IError> E>
+    // NOLINTNEXTLINE(*explicit*)
+    CRAB_INLINE AnyError(E error): held{Storage::make<E>(mem::move(error))} {}
+
+    /// Takes ownership of an existing heap allocated error
+    template<std::derived_from<IError> E>
+    // NOLINTNEXTLINE(*explicit*)
+    CRAB_INLINE AnyError(boxed::Box<E> error): held{mem::move(error)} {}
+
+    /// Holds the given error code, this is always stored inline
+    // NOLINTNEXTLINE(*explicit*)
+    CRAB_INLINE AnyError(const ErrorCode code): held{Storage::make<impl::ErrorCodeError>(code)} {}
+
+    /// The held error
+    [[nodiscard]] CRAB_INLINE auto get() const -> const IError& {
+      return held.as_ref();
+    }
+
+    /// The held error
+    [[nodiscard]] CRAB_INLINE auto get_mut() -> IError& {
+      return held.as_mut();
+    }
+
+    /// Stringified error message of the held error
+    [[nodiscard]] CRAB_INLINE auto what() const -> String {
+      return get().what();
+    }
+
+    /// Whether the held error is stored inline, rather than on the heap
+    [[nodiscard]] CRAB_INLINE auto is_inline() const -> bool {
+      return held.is_inline();
+    }
+
+    /// Whether the held error is an E (or derives from E)
+    template<std::derived_from<IError> E>
+    [[nodiscard]] CRAB_INLINE auto is() const -> bool {
+      return downcast<E>().is_some();
+    }
+
+    /// Attempts to downcast the held error to an E
+    template<std::derived_from<IError> E>
+    [[nodiscard]] CRAB_INLINE auto downcast() const -> opt::Option<const E&> {
+      return held.downcast<E>();
+    }
+
+    /// Attempts to downcast the held error to an E
+    template<std::derived_from<IError> E>
+    [[nodiscard]] CRAB_INLINE auto downcast() -> opt::Option<E&> {
+      return held.downcast<E>();
+    }
+
+    /// The held error code, if this holds one
+    [[nodiscard]] CRAB_INLINE auto error_code() const -> opt::Option<ErrorCode> {
+      return downcast<impl::ErrorCodeError>().map([](const impl::ErrorCodeError& wrapped) {
+        return wrapped.error_code();
+      });
+    }
+
+  private:
+
+    CRAB_INLINE explicit AnyError(Storage error): held{mem::move(error)} {}
+
+    /// Byte offset of the niche of the box, for the niche of AnyError
+    [[nodiscard]] static CRAB_CONSTEVAL auto niche_offset() -> usize {
+      return offsetof(AnyError, held) + opt::Niche<Storage>::NicheOffset;
+    }
+
+    friend struct opt::Niche<AnyError>;
+
+    Storage held;
+  };
+
+  /// Constructs an E from the given arguments inside of a new AnyError, see AnyError::make
+  /// @ingroup result
+  template<std::derived_from<IError> E, typename... Args>
+  requires std::constructible_from<E, Args...>
+  [[nodiscard]] CRAB_INLINE auto make_any_error(Args&&... args) -> AnyError {
+    return AnyError::make<E>(mem::forward<Args>(args)...);
+  }
+}
+
+namespace crab {
+  /// The box inside of a valid AnyError is never null
+  /// @ingroup result
+  template<>
+  struct opt::Niche<result::AnyError> :
+      opt::BitNiche<result::AnyError, const void*, nullptr, result::AnyError::niche_offset()> {};
+}
+
+/// Formats the error held by an AnyError, an ErrorCode is formatted without allocating
+/// @relates AnyError
+template<typename Char>
+struct fmt::formatter<crab::result::AnyError, Char> {
+  constexpr auto parse(parse_context<Char>& ctx) {
+    return ctx.begin();
+  }
+
+  template<typename FormatContext>
+  auto format(const crab::result::AnyError& error, FormatContext& ctx) const -> decltype(ctx.out()) {
+    if (const auto code{error.error_code()}; code.is_some()) {
+      return fmt::format_to(ctx.out(), "{}", code.get_unchecked(crab::unsafe));
+    }
+
+    return fmt::format_to(ctx.out(), "{}", error.what());
+  }
+};
+
+namespace crab {
+  using result::AnyError;
+  using result::make_any_error;
+}
+
+namespace crab::prelude {
+  using result::AnyError;
+}
+
+CRAB_PRELUDE_GUARD;
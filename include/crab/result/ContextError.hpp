@@ -0,0 +1,150 @@
+/// @file crab/result/ContextError.hpp
+/// @ingroup result
+///
+/// Error along with the context it was propagated through, see Result::context.
+#pragma once
+
+#include <array>
+#include <type_traits>
+
+#include "crab/assertion/check.hpp"
+#include "crab/assertion/fmt.hpp"
+#include "crab/core.hpp"
+#include "crab/mem/move.hpp"
+#include "crab/num/integer.hpp"
+#include "crab/opt/niche.hpp"
+#include "crab/str/StaticStr.hpp"
+#include "crab/ty/classify.hpp"
+
+namespace crab::result {
+
+  /// Error E along with the context frames (eg. "reading the config file") that were added to it as it was propagated
+  /// by Result::context / Result::with_context, outermost frame last.
+  ///
+  /// Frames are static strings kept inline, so adding context never allocates nor builds a string, they are only put
+  /// together when the error is formatted (as "outer: inner: error"). Only the MaxFrames outermost frames are kept,
+  /// adding one to a full error overwrites its innermost frame.
+  ///
+  /// If E has a niche, so does ContextError<E>.
+  /// @ingroup result
+  template<typename E>
+  class ContextError final {
+    static_assert(ty::non_reference<E>, "ContextError<E> cannot hold a reference");
+
+  public:
+
+    /// Number of frames that are kept
+    static constexpr usize MaxFrames{4};
+
+    /// Error without any context
+    // NOLINTNEXTLINE(*explicit*)
+    CRAB_INLINE constexpr ContextError(E error): inner{mem::move(error)} {}
+
+    /// Adds an outer frame of context
+    CRAB_INLINE constexpr auto push(const StaticStr context) -> void {
+      frames[depth % MaxFrames] = context;
+      depth++;
+    }
+
+    /// The error without its context
+    [[nodiscard]] CRAB_INLINE constexpr auto get() const -> const E& {
+      return inner;
+    }
+
+    /// The error without its context
+    [[nodiscard]] CRAB_INLINE constexpr auto get_mut() -> E& {
+      return inner;
+    }
+
+    /// Takes the error out, discarding its context
+    [[nodiscard]] CRAB_INLINE constexpr auto into_inner() && -> E {
+      return mem::move(inner);
+    }
+
+    /// Number of frames kept, at most MaxFrames
+    [[nodiscard]] CRAB_INLINE constexpr auto frame_count() const -> usize {
+      return depth < MaxFrames ? depth : MaxFrames;
+    }
+
+    /// Number of frames that were added, including the ones that were overwritten
+    [[nodiscard]] CRAB_INLINE constexpr auto total_frames() const -> usize {
+      return depth;
+    }
+
+    /// Gets a kept frame, where 0 is the outermost
+    [[nodiscard]] CRAB_INLINE constexpr auto frame(const usize index) const -> StaticStr {
+      crab_check(index < frame_count(), "Context frame {} out of range of {} frames", index, frame_count());
+      return frames[(depth - 1 - index) % MaxFrames];
+    }
+
+  private:
+
+    /// Kept first so that the niche of E (if any) lies at the same offset in ContextError<E>
+    E inner;
+    std::array<StaticStr, MaxFrames> frames{};
+    usize depth{0};
+  };
+
+  namespace impl {
+    /// @internal
+    template<typename>
+    struct is_context_error final : ty::false_type {};
+
+    /// @internal
+    template<typename E>
+    struct is_context_error<ContextError<E>> final : ty::true_type {};
+
+    /// ContextError<E>, unless E already is one
+    /// @internal
+    template<typename E>
+    using ContextErrorOf = std::conditional_t<is_context_error<E>::value, E, ContextError<E>>;
+  }
+}
+
+namespace crab {
+  /// ContextError<E> keeps the niche of E, which lies at the start of it
+  /// @ingroup result
+  template<opt::has_placed_niche E>
+  struct opt::Niche<result::ContextError<E>> : opt::Niche<E> {};
+}
+
+/// Formats a ContextError<E> as its frames, outermost first, followed by the error
+/// @relates ContextError
+template<fmt::formattable E, typename Char>
+struct fmt::formatter<crab::result::ContextError<E>, Char> {
+private:
+
+  formatter<E, Char> error_formatter;
+
+public:
+
+  constexpr auto parse(parse_context<Char>& ctx) {
+    return ctx.begin();
+  }
+
+  template<typename FormatContext>
+  auto format(const crab::result::ContextError<E>& error, FormatContext& ctx) const -> decltype(ctx.out()) {
+    auto out = ctx.out();
+
+    for (crab::usize i = 0; i < error.frame_count(); i++) {
+      out = fmt::format_to(out, "{}: ", error.frame(i).view());
+    }
+
+    if (error.total_frames() > error.frame_count()) {
+      out = fmt::format_to(out, "({} more): ", error.total_frames() - error.frame_count());
+    }
+
+    ctx.advance_to(out);
+    return error_formatter.format(error.get(), ctx);
+  }
+};
+
+namespace crab {
+  using result::ContextError;
+}
+
+namespace crab::prelude {
+  using result::ContextError;
+}
+
+CRAB_PRELUDE_GUARD;
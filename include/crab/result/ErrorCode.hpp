@@ -0,0 +1,213 @@
+/// @file crab/result/ErrorCode.hpp
+/// @ingroup result
+///
+/// Allocation free error values, for error paths that are too hot to construct an IError (and its message) on.
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+#include "crab/assertion/fmt.hpp"
+#include "crab/boxed/Box.hpp"
+#include "crab/core.hpp"
+#include "crab/num/integer.hpp"
+#include "crab/opt/Option.hpp"
+#include "crab/opt/niche.hpp"
+#include "crab/result/Error.hpp"
+#include "crab/str/str.hpp"
+
+namespace crab::result {
+
+  /// Category of an ErrorCode, this gives the meaning of its values. Categories are expected to be static objects that
+  /// outlive every ErrorCode referring to them.
+  ///
+  /// # Examples
+  /// ```cpp
+  /// enum class ParseError : i32 { Empty, NotDigit };
+  ///
+  /// struct ParseErrorCategory final : crab::ErrorCategory {
+  ///   auto name() const -> StringView override { return "parse"; }
+  ///
+  ///   auto message(const i32 value) const -> StringView override {
+  ///     switch (static_cast<ParseError>(value)) {
+  ///       case ParseError::Empty: return "empty input";
+  ///       case ParseError::NotDigit: return "expected a digit";
+  ///     }
+  ///     return "unknown";
+  ///   }
+  /// };
+  ///
+  /// constexpr ParseErrorCategory parse_error_category;
+  ///
+  /// Result<u32, ErrorCode> result{ErrorCode{parse_error_category, ParseError::Empty}};
+  /// ```
+  /// @ingroup result
+  class ErrorCategory {
+  public:
+
+    constexpr ErrorCategory() = default;
+
+    ErrorCategory(const ErrorCategory&) = delete;
+
+    ErrorCategory(ErrorCategory&&) = delete;
+
+    auto operator=(const ErrorCategory&) -> ErrorCategory& = delete;
+
+    auto operator=(ErrorCategory&&) -> ErrorCategory& = delete;
+
+    /// Short name of the category, eg. "io" or "parse"
+    [[nodiscard]] virtual auto name() const -> StringView = 0;
+
+    /// Description of the given value of this category
+    [[nodiscard]] virtual auto message(i32 value) const -> StringView = 0;
+
+  protected:
+
+    /// Categories are never destroyed through a pointer to ErrorCategory, this is left non-virtual so that a category
+    /// can be constexpr.
+    constexpr ~ErrorCategory() = default;
+  };
+
+  /// Trivially copyable error, which is a category, a value within that category, and an optional static context
+  /// string saying what was being done when the error occurred.
+  ///
+  /// Unlike an IError, constructing & passing around an ErrorCode never allocates, its message is only put together
+  /// when it is formatted (or what() is called).
+  ///
+  /// ErrorCode has a niche (the category is never null), so Option<ErrorCode> is the same size as ErrorCode and a small
+  /// Ok type shares its bytes in a Result<T, ErrorCode>.
+  /// @ingroup result
+  class ErrorCode final {
+  public:
+
+    /// Error with the given value in 'category', context must be nullptr or a string with static lifetime (eg. a
+    /// string literal).
+    CRAB_INLINE constexpr ErrorCode(const ErrorCategory& category, const i32 value, const char* const context = nullptr):
+        category_ptr{&category}, code{value}, context_str{context} {}
+
+    /// Error with the given enum value in 'category'
+    template<typename Enum>
+    requires std::is_enum_v<Enum>
+    CRAB_INLINE constexpr ErrorCode(const ErrorCategory& category, const Enum value, const char* const context = nullptr):
+        ErrorCode{category, static_cast<i32>(value), context} {}
+
+    /// Category this error's value belongs to
+    [[nodiscard]] CRAB_INLINE constexpr auto category() const -> const ErrorCategory& {
+      return *category_ptr;
+    }
+
+    [[nodiscard]] CRAB_INLINE constexpr auto value() const -> i32 {
+      return code;
+    }
+
+    /// Static context given to this error, if any
+    [[nodiscard]] CRAB_INLINE constexpr auto context() const -> opt::Option<StringView> {
+      if (context_str == nullptr) {
+        return crab::none;
+      }
+      return StringView{context_str};
+    }
+
+    /// Copy of this error with the given static context, replacing any it already had
+    [[nodiscard]] CRAB_INLINE constexpr auto with_context(const char* const context) const -> ErrorCode {
+      return ErrorCode{*category_ptr, code, context};
+    }
+
+    /// Description of this error's value, without its context
+    [[nodiscard]] CRAB_INLINE auto message() const -> StringView {
+      return category_ptr->message(code);
+    }
+
+    /// Stringified error message for logging purposes, this allocates (prefer formatting the code directly)
+    [[nodiscard]] auto what() const -> String;
+
+    /// Converts this into a (heap allocated) IError, for APIs that take any error
+    [[nodiscard]] auto into_error() const -> boxed::Box<IError>;
+
+    /// Two codes are equal if they have the same category & value, regardless of their context
+    [[nodiscard]] CRAB_INLINE constexpr auto operator==(const ErrorCode& other) const -> bool {
+      return category_ptr == other.category_ptr and code == other.code;
+    }
+
+  private:
+
+    friend struct opt::Niche<ErrorCode>;
+
+    const ErrorCategory* category_ptr;
+    i32 code;
+    const char* context_str;
+  };
+
+  namespace impl {
+
+    /// IError holding an ErrorCode, see ErrorCode::into_error
+    /// @internal
+    class ErrorCodeError final : public IError {
+    public:
+
+      CRAB_INLINE explicit ErrorCodeError(const ErrorCode code): code{code} {}
+
+      [[nodiscard]] auto what() const -> String override {
+        return code.what();
+      }
+
+      [[nodiscard]] CRAB_INLINE auto error_code() const -> const ErrorCode& {
+        return code;
+      }
+
+    private:
+
+      ErrorCode code;
+    };
+  }
+
+  inline auto ErrorCode::into_error() const -> boxed::Box<IError> {
+    return boxed::make_box<impl::ErrorCodeError>(*this);
+  }
+}
+
+namespace crab {
+  /// The category of an ErrorCode is never null
+  /// @ingroup result
+  template<>
+  struct opt::Niche<result::ErrorCode> :
+      opt::BitNiche<result::ErrorCode, const void*, nullptr, offsetof(result::ErrorCode, category_ptr)> {};
+}
+
+/// Formats an ErrorCode as "context: message (category:value)", without allocating
+/// @relates ErrorCode
+template<typename Char>
+struct fmt::formatter<crab::result::ErrorCode, Char> {
+  constexpr auto parse(parse_context<Char>& ctx) {
+    return ctx.begin();
+  }
+
+  template<typename FormatContext>
+  auto format(const crab::result::ErrorCode& code, FormatContext& ctx) const -> decltype(ctx.out()) {
+    auto out = ctx.out();
+
+    if (const auto context{code.context()}; context.is_some()) {
+      out = fmt::format_to(out, "{}: ", context.get_unchecked(crab::unsafe));
+    }
+
+    return fmt::format_to(out, "{} ({}:{})", code.message(), code.category().name(), code.value());
+  }
+};
+
+namespace crab::result {
+  inline auto ErrorCode::what() const -> String {
+    return fmt::format("{}", *this);
+  }
+}
+
+namespace crab {
+  using result::ErrorCategory;
+  using result::ErrorCode;
+}
+
+namespace crab::prelude {
+  using result::ErrorCategory;
+  using result::ErrorCode;
+}
+
+CRAB_PRELUDE_GUARD;
@@ -15,8 +15,11 @@
 #include "crab/mem/forward.hpp"
 #include "crab/opt/Option.hpp"
 #include "crab/result/Ok.hpp"
+#include "crab/result/ContextError.hpp"
 #include "crab/result/Err.hpp"
 #include "crab/result/Error.hpp"
+#include "crab/result/impl/ResultStorage.hpp"
+#include "crab/str/StaticStr.hpp"
 
 namespace crab::result {
 
@@ -54,7 +57,7 @@ namespace crab::result {
     };
 
     /// Concept for if this result is copyable
-    inline static constexpr bool is_copyable{std::copyable<T> and std::copyable<E>};
+    inline static constexpr bool is_copyable{ty::copyable_object<T> and ty::copyable_object<E>};
 
     /// Concept for if this result is
     inline static constexpr bool implicit_copy_allowed{
@@ -63,22 +66,23 @@ namespace crab::result {
 
   private:
 
-    /// Type for the internal storage of this result.
+    /// Type for the internal storage of this result, an AnyOf<Ok, Err> unless the tag can be kept in a niche of T or E
+    /// (see impl::ResultStorage).
     /// @internal
-    using AnyOf = any::AnyOf<Ok, Err>;
+    using Storage = impl::ResultStorage<Ok, Err>;
 
   public:
 
     /// Copy construction from an Ok type. This constructor is not available if the type is not copyable, is a reference
     /// type, or if this result's ok and error types are the same. If this constructor is unvailable, consider
     /// Result::Result(T&&) or Result::Result(Ok)
-    CRAB_INLINE constexpr Result(const T& from) requires(not is_same and std::copyable<T> and not ty::is_reference<T>)
+    CRAB_INLINE constexpr Result(const T& from) requires(not is_same and ty::copyable_object<T> and not ty::is_reference<T>)
         : Result{T(from)} {}
 
     /// Copy construction from an Error type. This constructor is not available if the type is not copyable, is a
     /// reference type, or if this result's ok and error types are the same. If this constructor is unvailable, consider
     /// Result::Result(E&&) or Result::Result(Err)
-    CRAB_INLINE constexpr Result(const E& from) requires(not is_same and std::copyable<E> and not ty::is_reference<T>)
+    CRAB_INLINE constexpr Result(const E& from) requires(not is_same and ty::copyable_object<E> and not ty::is_reference<T>)
         : Result{E(from)} {}
 
     /// Move / perfect forward constructor for an Ok type. This method is unavailable if this results error and ok types
@@ -95,10 +99,10 @@ namespace crab::result {
 
     /// Constructs a result with the given 'Ok' value. This constructor is always available no matter the ok or error
     /// type.
-    CRAB_INLINE constexpr Result(Ok from): storage{AnyOf::template from<Ok>(mem::move(from))} {}
+    CRAB_INLINE constexpr Result(Ok from): storage{Storage::template from<Ok>(mem::move(from))} {}
 
     /// Constructs a result with the given 'Err value. This constructor is always available no matter the ok or error
-    CRAB_INLINE constexpr Result(Err from): storage{AnyOf::template from<Err>(mem::move(from))} {}
+    CRAB_INLINE constexpr Result(Err from): storage{Storage::template from<Err>(mem::move(from))} {}
 
     /// Reassigns this option to the given 'Ok' value
     CRAB_INLINE constexpr auto operator=(Ok from) -> Result& {
@@ -198,7 +202,10 @@ namespace crab::result {
       return storage.template is_unchecked<Err>(unsafe);
     }
 
-    /// TODO: doc
+    /// Returns whether this result is not in a moved-from state, this may be called on a moved-from result.
+    ///
+    /// Note that a result whose tag is kept in a niche of T or E (eg. Result<Option<u64>, u32>) has no moved-from state,
+    /// both are trivially copyable so moving out of it leaves it as it was and this is always true.
     [[nodiscard]] auto is_valid() const -> bool {
       return storage.is_valid();
     }
@@ -617,6 +624,44 @@ namespace crab::result {
       return std::invoke(functor, mem::move(*this).unwrap_unchecked(unsafe));
     }
 
+    /// Consumes self and if Err, adds the given context to the error as an outer frame (see ContextError). The error
+    /// is wrapped in a ContextError<E> unless it already is one, in which case the frame is added to it.
+    ///
+    /// This never allocates, the context is only put together with the error when it is formatted.
+    ///
+    /// # Examples
+    /// ```cpp
+    /// auto read_config(StringView path) -> Result<Config, ContextError<ErrorCode>> {
+    ///   String text{co_await read_file(path).context("reading the config file")};
+    ///   co_return parse_config(text).context("parsing the config file");
+    /// }
+    ///
+    /// // "Err(parsing the config file: expected a digit (parse:1))"
+    /// fmt::println("{}", read_config("app.cfg"));
+    /// ```
+    [[nodiscard]] CRAB_INLINE constexpr auto context(const StaticStr context) && -> Result<T, impl::ContextErrorOf<E>>
+    requires ty::non_reference<E>
+    {
+      return mem::move(*this).with_context([context] { return context; });
+    }
+
+    /// Version of Result::context(StaticStr) that only gets the context (by calling 'make_context') if this is Err.
+    ///
+    /// @copydoc Result::context(StaticStr)
+    template<std::invocable F>
+    requires ty::non_reference<E> and std::convertible_to<std::invoke_result_t<F>, StaticStr>
+    [[nodiscard]] CRAB_INLINE constexpr auto with_context(F&& make_context) && -> Result<T, impl::ContextErrorOf<E>> {
+      using R = Result<T, impl::ContextErrorOf<E>>;
+
+      if (is_ok()) {
+        return R{result::Ok<T>{mem::move(*this).unwrap_unchecked(unsafe)}};
+      }
+
+      impl::ContextErrorOf<E> error{mem::move(*this).unwrap_err_unchecked(unsafe)};
+      error.push(std::invoke(mem::forward<F>(make_context)));
+      return R{result::Err<impl::ContextErrorOf<E>>{mem::move(error)}};
+    }
+
     /// Takes Ok value out of this object and returns it, if is Err and not
     /// Ok, an empty option will be returned instead.
     ///
@@ -668,12 +713,16 @@ namespace crab::result {
     constexpr auto check_is_ok(const SourceLocation loc = SourceLocation::current()) const -> void {
       check_unmoved();
 
-      crab_check_with_location(
-        is_ok(),
-        loc,
-        "Excepted result to contain an 'Ok' value, instead found error: {}",
-        get_err_unchecked(unsafe)
-      );
+      if constexpr (fmt::formattable<E>) {
+        crab_check_with_location(
+          is_ok(),
+          loc,
+          "Excepted result to contain an 'Ok' value, instead found error: {}",
+          get_err_unchecked(unsafe)
+        );
+      } else {
+        crab_check_with_location(is_ok(), loc, "Excepted result to contain an 'Ok' value, instead found an error.");
+      }
     }
 
     /// Debug only check.
@@ -718,8 +767,8 @@ namespace crab::result {
     }
 
     /// @internal
-    /// Internal storage for any Result, this uses a plain AnyOf
-    AnyOf storage;
+    /// Internal storage for any Result
+    Storage storage;
   };
 
   // NOLINTEND(*explicit*)
@@ -31,12 +31,12 @@ namespace crab::result {
   /// A valid error type for use in Err<T> / Result<_, E>
   /// @ingroup ref
   template<typename E>
-  concept error_type = ty::movable<E> or ty::is_reference<E>;
+  concept error_type = ty::movable_object<E> or ty::is_reference<E>;
 
   /// Type constraint for a type that can be used with Result<T>
   /// @ingroup ref
   template<typename T>
-  concept ok_type = ty::movable<T> or ty::is_reference<T>;
+  concept ok_type = ty::movable_object<T> or ty::is_reference<T>;
 
   namespace impl {
     /// Whether type T is the 'Ok' wrapper Ok<K>
@@ -0,0 +1,81 @@
+/// @file crab/result/coroutine.hpp
+/// @ingroup result
+///
+/// Lets a function returning a Result be written as a coroutine, in which co_await'ing another Result unwraps it, or
+/// returns early with its error.
+///
+/// ```cpp
+/// auto parse_header(Reader& reader) -> Result<Header, ParseError> {
+///   const u32 magic{co_await reader.read_u32()};
+///   const u16 version{co_await reader.read_u16()};
+///
+///   co_return Header{magic, version};
+/// }
+/// ```
+///
+/// This is the same as checking is_err & returning unwrap_err after every call, the error of a co_await'ed result
+/// only has to be convertible to the error of the coroutine's. It is not as cheap however: the coroutine's frame is
+/// allocated (from a pool) unless the compiler elides it, which GCC never does, making a co_await several times slower
+/// than the check it replaces (see crab/core/impl/TryPromise.hpp). Prefer checking by hand on hot paths.
+
+#pragma once
+
+#include <coroutine>
+
+#include "crab/core.hpp"
+#include "crab/core/impl/TryPromise.hpp"
+#include "crab/core/unsafe.hpp"
+#include "crab/mem/move.hpp"
+#include "crab/result/Result.hpp"
+#include "crab/ty/construct.hpp"
+
+namespace crab::result::impl {
+
+  /// Awaiter for a Result co_await'ed in a coroutine returning Result<T, E>
+  /// @internal
+  template<typename T, typename E, typename U, typename F>
+  class ResultAwaiter final {
+  public:
+
+    CRAB_INLINE explicit ResultAwaiter(Result<U, F>& result): result{result} {}
+
+    [[nodiscard]] CRAB_INLINE auto await_ready() const -> bool {
+      return result.is_ok();
+    }
+
+    /// Returns early from the coroutine with the error of the awaited result
+    template<typename Promise>
+    CRAB_INLINE auto await_suspend(const std::coroutine_handle<Promise> handle) -> void {
+      handle.promise().return_early(handle, Result<T, E>{Err<E>{mem::move(result).unwrap_err_unchecked(unsafe)}});
+    }
+
+    [[nodiscard]] CRAB_INLINE auto await_resume() -> U {
+      return mem::move(result).unwrap_unchecked(unsafe);
+    }
+
+  private:
+
+    Result<U, F>& result;
+  };
+
+  /// Promise type for a coroutine returning Result<T, E>
+  /// @internal
+  template<typename T, typename E>
+  class ResultPromise final : public crab::impl::TryPromise<Result<T, E>, ResultPromise<T, E>> {
+  public:
+
+    /// Unwraps the given result, or returns early with its error
+    template<typename U, typename F>
+    requires ty::convertible<F, E>
+    [[nodiscard]] CRAB_INLINE auto await_transform(Result<U, F>&& result) -> ResultAwaiter<T, E, U, F> {
+      return ResultAwaiter<T, E, U, F>{result};
+    }
+  };
+}
+
+/// Makes any function returning a Result able to be a coroutine
+/// @relates crab::result::Result
+template<typename T, typename E, typename... Args>
+struct std::coroutine_traits<crab::result::Result<T, E>, Args...> {
+  using promise_type = crab::result::impl::ResultPromise<T, E>;
+};
@@ -0,0 +1,194 @@
+/// @file crab/result/impl/ResultStorage.hpp
+/// @internal
+///
+/// Layout of Result<T, E>. By default a result is an AnyOf<Ok<T>, Err<E>>, which keeps a separate index after the
+/// larger of the two. If both sides are trivially copyable, either side has a niche (see opt::Niche) and the other side
+/// fits in the bytes around it, the result is instead stored in that side's bytes, with the niche's bit pattern marking
+/// that it holds the other side.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#include "crab/any/AnyOf.hpp"
+#include "crab/assertion/check.hpp"
+#include "crab/core.hpp"
+#include "crab/core/unsafe.hpp"
+#include "crab/mem/forward.hpp"
+#include "crab/mem/move.hpp"
+#include "crab/num/integer.hpp"
+#include "crab/opt/niche.hpp"
+#include "crab/ty/classify.hpp"
+#include "crab/ty/compare.hpp"
+
+#if CRAB_GCC_VERSION
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+namespace crab::result::impl {
+
+  /// Offset within Niched that Packed is stored at, or NoFit if Packed cannot be stored without overlapping the niche.
+  /// @internal
+  inline constexpr usize NoFit{static_cast<usize>(-1)};
+
+  /// Where a Packed value can be stored within the bytes of a Niched value while it does not hold one, which is either
+  /// before the niche or after it. An empty value takes up no bytes, and so fits anywhere.
+  /// @internal
+  template<typename Niched, typename Packed>
+  [[nodiscard]] CRAB_CONSTEVAL auto packed_offset() -> usize {
+    using Inner = typename Niched::Inner;
+
+    if constexpr (std::is_empty_v<typename Packed::Inner>) {
+      return 0;
+    } else if constexpr (opt::has_placed_niche<Inner>) {
+      constexpr usize niche_begin{opt::Niche<Inner>::NicheOffset};
+      constexpr usize niche_end{niche_begin + opt::Niche<Inner>::NicheSize};
+      constexpr usize after_niche{(niche_end + alignof(Packed) - 1) / alignof(Packed) * alignof(Packed)};
+
+      if constexpr (sizeof(Packed) <= niche_begin) {
+        return 0;
+      } else if constexpr (after_niche + sizeof(Packed) <= sizeof(Niched)) {
+        return after_niche;
+      } else {
+        return NoFit;
+      }
+    } else {
+      return NoFit;
+    }
+  }
+
+  /// Whether a result can be stored as a Niched value, with Packed stored in the bytes around its niche. Both must be
+  /// trivially copyable: Packed is written around (and read back from) bytes that the niche & Niched share, and moving
+  /// out of a trivially copyable Niched leaves it as it was. A type whose moved-from value is its niche (eg. a null Box)
+  /// would otherwise leave a moved-from result that reads as holding Packed.
+  /// @internal
+  template<typename Niched, typename Packed>
+  concept packs_into = ty::non_reference<typename Niched::Inner> and opt::has_niche<typename Niched::Inner>
+                   and std::is_trivially_copyable_v<Niched> and std::is_trivially_copyable_v<Packed>
+                   and alignof(Packed) <= alignof(Niched) and packed_offset<Niched, Packed>() != NoFit;
+
+  /// Storage for a result that holds either a Niched or Packed value (one of Ok<T> / Err<E>) in the bytes of Niched,
+  /// holding Packed whenever those bytes have the niche of Niched's inner type.
+  ///
+  /// This is trivially copyable, & has no moved-from state: moving out of it leaves a copy of the moved-from value in
+  /// place (like a trivially copyable AnyOf), so it still holds the same side & is_valid is always true.
+  /// @internal
+  template<typename Niched, typename Packed>
+  class NichedStorage final {
+    using Niche = opt::Niche<typename Niched::Inner>;
+
+    static_assert(sizeof(Niched) == sizeof(typename Niched::Inner), "Ok<T> / Err<E> must be laid out as T / E");
+
+    /// @hideinitializer
+    static constexpr usize PackedOffset{packed_offset<Niched, Packed>()};
+
+    template<typename Alt>
+    static constexpr bool IsNiched{std::same_as<Alt, Niched>};
+
+    template<typename Alt>
+    CRAB_INLINE constexpr explicit NichedStorage(std::in_place_type_t<Alt>, Alt&& value) {
+      construct<Alt>(mem::move(value));
+    }
+
+  public:
+
+    /// Constructs storage holding the given value
+    template<ty::either<Niched, Packed> Alt>
+    [[nodiscard]] CRAB_INLINE static constexpr auto from(Alt value) -> NichedStorage {
+      return NichedStorage{std::in_place_type<Alt>, mem::move(value)};
+    }
+
+    /// Replaces the held value with one constructed from the given arguments
+    template<ty::either<Niched, Packed> Alt, typename... Args>
+    CRAB_INLINE constexpr auto emplace(Args&&... args) -> void {
+      construct<Alt>(mem::forward<Args>(args)...);
+    }
+
+    template<ty::either<Niched, Packed> Alt>
+    [[nodiscard]] CRAB_INLINE constexpr auto is_unchecked(unsafe_fn) const -> bool {
+      return holds_niched() == IsNiched<Alt>;
+    }
+
+    /// Always true, as there is no moved-from state
+    [[nodiscard]] CRAB_INLINE constexpr auto is_valid() const -> bool {
+      return true;
+    }
+
+    template<ty::either<Niched, Packed> Alt>
+    [[nodiscard]] CRAB_INLINE constexpr auto as_unchecked(unsafe_fn) & -> Alt& {
+      crab_dbg_check(is_unchecked<Alt>(unsafe), "as_unchecked<T> called on a result that does not contain T");
+      return as_ref<Alt>();
+    }
+
+    template<ty::either<Niched, Packed> Alt>
+    [[nodiscard]] CRAB_INLINE constexpr auto as_unchecked(unsafe_fn) const& -> const Alt& {
+      crab_dbg_check(is_unchecked<Alt>(unsafe), "as_unchecked<T> called on a result that does not contain T");
+      return as_ref<Alt>();
+    }
+
+    /// Copies the held value out, leaving it in place
+    template<ty::either<Niched, Packed> Alt>
+    [[nodiscard]] CRAB_INLINE constexpr auto as_unchecked(unsafe_fn) && -> Alt {
+      crab_dbg_check(is_unchecked<Alt>(unsafe), "as_unchecked<T> called on a result that does not contain T");
+      return as_ref<Alt>();
+    }
+
+  private:
+
+    /// Whether this holds a Niched value, rather than a Packed one
+    [[nodiscard]] CRAB_INLINE auto holds_niched() const -> bool {
+      return not Niche::is_none(bytes.data());
+    }
+
+    template<typename Alt>
+    [[nodiscard]] CRAB_INLINE CRAB_RETURNS_NONNULL auto address() -> Alt* {
+      return reinterpret_cast<Alt*>(bytes.data() + (IsNiched<Alt> ? 0 : PackedOffset));
+    }
+
+    template<typename Alt>
+    [[nodiscard]] CRAB_INLINE auto as_ref() -> Alt& {
+      return *std::launder(address<Alt>());
+    }
+
+    template<typename Alt>
+    [[nodiscard]] CRAB_INLINE auto as_ref() const -> const Alt& {
+      return *std::launder(reinterpret_cast<const Alt*>(bytes.data() + (IsNiched<Alt> ? 0 : PackedOffset)));
+    }
+
+    /// Constructs a value over the held one, which is trivially destructible. The niche is written after constructing a
+    /// Packed value in case it is an empty type that overlaps the niche.
+    template<typename Alt, typename... Args>
+    CRAB_INLINE auto construct(Args&&... args) -> void {
+      std::construct_at<Alt>(address<Alt>(), mem::forward<Args>(args)...);
+
+      if constexpr (IsNiched<Alt>) {
+        crab_dbg_check(
+          holds_niched(),
+          "Cannot store a value in a Result that has the same bit pattern as the niche of its type"
+        );
+      } else {
+        Niche::set_none(bytes.data());
+      }
+    }
+
+    alignas(Niched) std::array<std::byte, sizeof(Niched)> bytes;
+  };
+
+  /// Selects the layout of a Result<T, E> (see the top of this file), the Ok side is preferred to hold the niche if
+  /// either could.
+  /// @internal
+  template<typename Ok, typename Err>
+  using ResultStorage = std::conditional_t<
+    packs_into<Ok, Err>,
+    NichedStorage<Ok, Err>,
+    std::conditional_t<packs_into<Err, Ok>, NichedStorage<Err, Ok>, any::AnyOf<Ok, Err>>>;
+}
+
+#if CRAB_GCC_VERSION
+#pragma GCC diagnostic pop
+#endif
@@ -0,0 +1,79 @@
+/// @file crab/str/StaticStr.hpp
+
+#pragma once
+
+#include "crab/core.hpp"
+#include "crab/core/unsafe.hpp"
+#include "crab/num/integer.hpp"
+#include "crab/str/str.hpp"
+
+namespace crab {
+
+  /// Reference to a string with static storage duration (eg. a string literal), which can be stored & passed around
+  /// freely without copying or owning the string. This is the size of a pointer, the length is found when it is viewed.
+  ///
+  /// Only string literals (and other constant strings) convert implicitly, the conversion is checked at compile time,
+  /// so a StaticStr cannot be made from a string on the stack by mistake.
+  ///
+  /// # Examples
+  /// ```cpp
+  /// StaticStr context{"reading the config file"};
+  ///
+  /// StringView view{context.view()};
+  /// ```
+  class StaticStr final {
+  public:
+
+    /// Empty string
+    CRAB_INLINE constexpr StaticStr() = default;
+
+    /// Refers to the given string literal
+    template<usize N>
+    // NOLINTNEXTLINE(*explicit*)
+    CRAB_CONSTEVAL StaticStr(const char (&literal)[N]): str{literal} {}
+
+    /// Refers to the given null terminated string.
+    ///
+    /// # Safety
+    /// The string must never be freed nor modified.
+    [[nodiscard]] CRAB_INLINE static constexpr auto from_raw(unsafe_fn, const char* const str) -> StaticStr {
+      StaticStr from;
+      from.str = str;
+      return from;
+    }
+
+    [[nodiscard]] CRAB_INLINE constexpr auto view() const -> StringView {
+      return StringView{str};
+    }
+
+    /// Null terminated string
+    [[nodiscard]] CRAB_INLINE constexpr auto c_str() const -> const char* {
+      return str;
+    }
+
+    // NOLINTNEXTLINE(*explicit*)
+    [[nodiscard]] CRAB_INLINE constexpr operator StringView() const {
+      return view();
+    }
+
+    [[nodiscard]] CRAB_INLINE constexpr auto operator==(const StaticStr& other) const -> bool {
+      return view() == other.view();
+    }
+
+  private:
+
+    const char* str{""};
+  };
+
+  /// Formats the referenced string
+  [[nodiscard]] CRAB_INLINE constexpr auto format_as(const StaticStr str) -> StringView {
+    return str.view();
+  }
+
+}
+
+namespace crab::prelude {
+  using crab::StaticStr;
+}
+
+CRAB_PRELUDE_GUARD;
@@ -5,20 +5,14 @@
 #pragma once
 
 #include "crab/num/integer.hpp"
+#include "crab/ty/pack.hpp"
 
 #include <concepts>
-#include <tuple>
 
 namespace crab::ty {
   /// @addtogroup ty
   /// @{
 
-  /// 'indexes' into a variadic pack to get the nth type
-  ///
-  /// TODO: move nth_type to a more suitable header
-  template<usize Index, typename... T>
-  using nth_type = std::tuple_element_t<Index, std::tuple<T...>>;
-
   /// Requirement for the two given types to be exactly the same.
   template<typename A, typename B>
   concept same_as = std::same_as<A, B>;
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <concepts>
+#include <type_traits>
 
 namespace crab::ty {
   /// @addtogroup ty
@@ -33,6 +34,17 @@ namespace crab::ty {
   template<typename T>
   concept movable = std::movable<T>;
 
+  /// Requirement for T to be an object type that is move constructible and assignable. This is ty::movable without its
+  /// check for swappable, which is costly to instantiate, for constraints that every instantiation of a common type
+  /// checks (eg. Result).
+  template<typename T>
+  concept movable_object = std::is_object_v<T> and std::is_move_constructible_v<T> and std::is_move_assignable_v<T>;
+
+  /// Requirement for T to be an object type that is copy constructible and assignable, this is ty::copyable without its
+  /// check for swappable (see ty::movable_object).
+  template<typename T>
+  concept copyable_object = movable_object<T> and std::is_copy_constructible_v<T> and std::is_copy_assignable_v<T>;
+
   /// Requirement for T to be default constructible
   template<typename T>
   concept default_constructible = std::is_default_constructible_v<T>;
@@ -0,0 +1,84 @@
+/// @file crab/ty/pack.hpp
+/// @ingroup ty
+///
+/// crab::ty helpers for indexing into & searching variadic packs of types.
+///
+/// These are used by every instantiation of AnyOf (and so Result), so they are written to keep the number of template
+/// instantiations per pack linear, rather than instantiating a std::tuple or a helper per pair of types.
+
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+#include "crab/core.hpp"
+#include "crab/num/integer.hpp"
+
+namespace crab::ty {
+  /// @addtogroup ty
+  /// @{
+
+  namespace impl {
+
+    /// @internal
+    /// A type along with its position in a pack
+    template<usize I, typename T>
+    struct PackElement {
+      using type = T;
+    };
+
+    /// @internal
+    /// Every type in a pack along with its position, as base classes. This is instantiated once per pack and shared by
+    /// every lookup into it.
+    template<typename Indices, typename... Ts>
+    struct IndexedPack;
+
+    template<usize... Is, typename... Ts>
+    struct IndexedPack<std::index_sequence<Is...>, Ts...> : PackElement<Is, Ts>... {};
+
+    /// @internal
+    template<typename... Ts>
+    using IndexedPackOf = IndexedPack<std::index_sequence_for<Ts...>, Ts...>;
+
+    /// @internal
+    /// Deduces the type at position I from the base classes of an IndexedPack.
+    template<usize I, typename T>
+    auto element_at(const PackElement<I, T>&) -> PackElement<I, T>;
+
+    /// @internal
+    /// Deduces the position of T from the base classes of an IndexedPack, this is ambiguous (and so fails) if T
+    /// appears more than once.
+    template<typename T, usize I>
+    auto position_of(const PackElement<I, T>&) -> std::integral_constant<usize, I>;
+
+  }
+
+  /// 'indexes' into a variadic pack to get the nth type
+  ///
+  /// This uses the compiler's builtin where there is one, otherwise a single overload resolution against the pack's
+  /// IndexedPack.
+  /// @hideinitializer
+#if CRAB_HAS_BUILTIN(__type_pack_element)
+  template<usize Index, typename... T>
+  using nth_type = __type_pack_element<Index, T...>;
+#else
+  template<usize Index, typename... T>
+  using nth_type = typename decltype(impl::element_at<Index>(std::declval<impl::IndexedPackOf<T...>>()))::type;
+#endif
+
+  /// Whether T appears exactly once in the pack
+  template<typename T, typename... Ts>
+  concept unique_in = requires { impl::position_of<T>(std::declval<impl::IndexedPackOf<Ts...>>()); };
+
+  /// Whether no type appears more than once in the pack
+  template<typename... Ts>
+  concept unique_types = (unique_in<Ts, Ts...> and ...);
+
+  /// Position of T within the pack, T must appear exactly once.
+  /// @hideinitializer
+  template<typename T, typename... Ts>
+  requires unique_in<T, Ts...>
+  inline constexpr usize index_of{decltype(impl::position_of<T>(std::declval<impl::IndexedPackOf<Ts...>>()))::value};
+
+  /// }@
+}
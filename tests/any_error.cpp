@@ -0,0 +1,132 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <crab/preamble.hpp>
+
+namespace {
+  class Timeout final : public crab::IError {
+  public:
+
+    Timeout(const u32 millis, usize& alive): millis{millis}, alive{&alive} {
+      (*this->alive)++;
+    }
+
+    Timeout(Timeout&& from) noexcept: millis{from.millis}, alive{from.alive} {
+      (*alive)++;
+    }
+
+    Timeout(const Timeout&) = delete;
+
+    auto operator=(const Timeout&) -> Timeout& = delete;
+
+    auto operator=(Timeout&&) -> Timeout& = delete;
+
+    ~Timeout() override {
+      (*alive)--;
+    }
+
+    [[nodiscard]] auto what() const -> String override {
+      return fmt::format("timed out after {}ms", millis);
+    }
+
+    u32 millis;
+
+  private:
+
+    usize* alive;
+  };
+
+  /// Too large to be stored inline
+  class Trace final : public crab::IError {
+  public:
+
+    [[nodiscard]] auto what() const -> String override {
+      return "trace";
+    }
+
+    std::array<u64, 8> frames{};
+  };
+
+  struct CallCategory final : crab::ErrorCategory {
+    [[nodiscard]] auto name() const -> StringView override {
+      return "call";
+    }
+
+    [[nodiscard]] auto message(const i32) const -> StringView override {
+      return "refused";
+    }
+  };
+
+  constexpr CallCategory call_category;
+}
+
+TEST_CASE("AnyError", "[result]") {
+  usize alive{0};
+
+  SECTION("Inline & Heap") {
+    {
+      const AnyError timeout{crab::make_any_error<Timeout>(500, alive)};
+      REQUIRE(timeout.is_inline());
+      REQUIRE(alive == 1);
+      CHECK(timeout.what() == "timed out after 500ms");
+      CHECK(fmt::format("{}", timeout) == "timed out after 500ms");
+
+      STATIC_CHECK(AnyError::fits_inline<Timeout>);
+      STATIC_CHECK_FALSE(AnyError::fits_inline<Trace>);
+
+      const AnyError trace{Trace{}};
+      CHECK_FALSE(trace.is_inline());
+      CHECK(trace.what() == "trace");
+
+      const AnyError boxed{crab::make_box<Timeout>(20, alive)};
+      CHECK_FALSE(boxed.is_inline());
+      CHECK(boxed.what() == "timed out after 20ms");
+      REQUIRE(alive == 2);
+    }
+
+    REQUIRE(alive == 0);
+  }
+
+  SECTION("Downcasting") {
+    AnyError error{crab::make_any_error<Timeout>(500, alive)};
+
+    REQUIRE(error.is<Timeout>());
+    REQUIRE_FALSE(error.is<Trace>());
+    REQUIRE(error.downcast<Trace>().is_none());
+    REQUIRE(error.error_code().is_none());
+
+    error.downcast<Timeout>().get().millis = 10;
+    CHECK(error.get().what() == "timed out after 10ms");
+  }
+
+  SECTION("Error codes") {
+    const AnyError error{ErrorCode{call_category, 3, "calling a peer"}};
+    REQUIRE(error.is_inline());
+    REQUIRE(error.error_code().is_some());
+    CHECK(error.error_code().get() == ErrorCode{call_category, 3});
+    CHECK(fmt::format("{}", error) == "calling a peer: refused (call:3)");
+  }
+
+  SECTION("In a Result") {
+    {
+      Result<u64, AnyError> result{crab::make_any_error<Timeout>(500, alive)};
+      REQUIRE(result.is_err());
+      CHECK(fmt::format("{}", result) == "Err(timed out after 500ms)");
+
+      result = 42_u64;
+      REQUIRE(result.is_ok());
+      REQUIRE(alive == 0);
+      CHECK(fmt::format("{}", result) == "Ok(42)");
+
+      result = crab::make_any_error<Timeout>(1, alive);
+      REQUIRE(result.is_err());
+      REQUIRE(result.get_err().is<Timeout>());
+
+      const AnyError error{crab::move(result).unwrap_err()};
+      CHECK(error.what() == "timed out after 1ms");
+      REQUIRE(alive == 1);
+    }
+
+    REQUIRE(alive == 0);
+  }
+}
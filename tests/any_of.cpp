@@ -1,6 +1,8 @@
 
 #include <catch2/catch_test_macros.hpp>
+#include <array>
 #include <type_traits>
+#include <utility>
 
 #include "crab/core/discard.hpp"
 #include "crab/preamble.hpp"
@@ -245,3 +247,195 @@ TEST_CASE("Reference Types") {
     }
   }
 }
+
+TEST_CASE("Multi Visit", "[anyof]") {
+  using Number = AnyOf<i32, u32, f32>;
+  using Text = AnyOf<String, MoveOnly>;
+
+  const crab::cases describe{
+    [](i32, const String&) { return 0; },
+    [](i32, const MoveOnly&) { return 1; },
+    [](u32, const auto&) { return 2; },
+    [](f32, const String&) { return 3; },
+    [](f32, const MoveOnly&) { return 4; },
+  };
+
+  SECTION("every combination") {
+    const std::array numbers{Number{i32{1}}, Number{u32{2}}, Number{f32{3}}};
+    std::array texts{Text{String{"a"}}, Text{MoveOnly{"b"}}};
+
+    CHECK(crab::any::visit(describe, numbers[0], texts[0]) == 0);
+    CHECK(crab::any::visit(describe, numbers[0], texts[1]) == 1);
+    CHECK(crab::any::visit(describe, numbers[1], texts[0]) == 2);
+    CHECK(crab::any::visit(describe, numbers[1], texts[1]) == 2);
+    CHECK(crab::any::visit(describe, numbers[2], texts[0]) == 3);
+    CHECK(crab::any::visit(describe, numbers[2], texts[1]) == 4);
+  }
+
+  SECTION("mutable & moved") {
+    Number number{u32{5}};
+    Text text{MoveOnly{"hello"}};
+
+    crab::any::visit(
+      crab::cases{
+        [](u32& n, MoveOnly& m) {
+          n++;
+          m.set_name("world");
+        },
+        [](auto&, auto&) {},
+      },
+      number,
+      text
+    );
+
+    CHECK(number.as<u32>().is_some_and([](u32 n) { return n == 6; }));
+    CHECK(text.as<MoveOnly>().is_some_and([](const MoveOnly& m) { return m.get_name() == "world"; }));
+
+    const String name{crab::any::visit(
+      crab::cases{
+        [](MoveOnly m, auto&&) -> String { return m.get_name(); },
+        [](auto&&, auto&&) -> String { return "other"; },
+      },
+      crab::move(text),
+      number
+    )};
+
+    CHECK(name == "world");
+    CHECK_FALSE(text.is_valid());
+  }
+
+  SECTION("exhaustiveness") {
+    const auto partial = [](i32, const String&) {};
+
+    STATIC_CHECK(crab::any::impl::VisitorForAnyOfs<decltype(describe), const Number&, const Text&>);
+    STATIC_CHECK_FALSE(crab::any::impl::VisitorForAnyOfs<decltype(partial), const Number&, const Text&>);
+    STATIC_CHECK_FALSE(crab::any::impl::VisitorForAnyOfs<decltype(describe), const Number&, const i32&>);
+  }
+
+  SECTION("many alternatives") {
+    using Wide = AnyOf<i8, i16, i32, i64, u8, u16, u32, u64, f32>;
+
+    const Wide a{u16{3}};
+    const Wide b{i64{4}};
+    const Wide c{f32{5}};
+
+    const auto sum{crab::any::visit([](auto x, auto y, auto z) { return f64(x) + f64(y) + f64(z); }, a, b, c)};
+    CHECK(sum == 12);
+  }
+}
+
+TEST_CASE("VariantVec", "[anyof]") {
+  SECTION("partitions") {
+    VariantVec<i32, String, MoveOnly> values;
+    values.push(i32{1});
+    values.push(String{"two"});
+    values.push(i32{3});
+    values.emplace<MoveOnly>("four");
+    values.push(AnyOf<i32, String, MoveOnly>{i32{5}});
+
+    CHECK(values.size() == 5);
+    CHECK(values.count<i32>() == 3);
+    CHECK(values.count<String>() == 1);
+    CHECK(values.count<MoveOnly>() == 1);
+
+    i32 sum{0};
+    values.for_each_of<i32>([&](const i32 value) { sum += value; });
+    CHECK(sum == 9);
+
+    values.for_each_of<i32>([](i32& value) { value *= 2; });
+    CHECK(values.of<i32>()[2] == 10);
+
+    usize visited{0};
+    values.for_each(crab::cases{
+      [&](const i32&) { visited++; },
+      [&](const String& string) { CHECK(string == "two"); visited++; },
+      [&](const MoveOnly& m) { CHECK(m.get_name() == "four"); visited++; },
+    });
+    CHECK(visited == 5);
+
+    values.clear();
+    CHECK(values.is_empty());
+  }
+
+  SECTION("ordered") {
+    OrderedVariantVec<i32, String> values;
+    values.push(String{"a"});
+    values.push(i32{1});
+    values.push(String{"b"});
+
+    REQUIRE(values.size() == 3);
+    CHECK(std::as_const(values).get(0).as<const String&>().is_some_and([](const String& s) { return s == "a"; }));
+    CHECK(values.get(1).as<i32&>().is_some_and([](const i32 v) { return v == 1; }));
+    CHECK(values.get(2).as<String&>().is_some_and([](const String& s) { return s == "b"; }));
+
+    values.get(1).match([](i32& v) { v = 7; }, [](String&) {});
+    CHECK(values.of<i32>()[0] == 7);
+
+    String joined;
+    values.for_each_in_order(crab::cases{
+      [&](const String& s) { joined += s; },
+      [&](const i32& v) { joined += std::to_string(v); },
+    });
+    CHECK(joined == "a7b");
+
+    CHECK_THROWS(values.get(3));
+  }
+}
+
+TEST_CASE("CompactAnyOf", "[anyof]") {
+  struct Large {
+    std::array<u64, 64> data;
+  };
+
+  using Compact = CompactAnyOf<16, i32, String, Large>;
+
+  STATIC_CHECK(Compact::IsSpilled<Large>);
+  STATIC_CHECK_FALSE(Compact::IsSpilled<i32>);
+  STATIC_CHECK(Compact::DataSize <= 32);
+  STATIC_CHECK(sizeof(Compact) < sizeof(AnyOf<i32, String, Large>));
+  STATIC_CHECK(sizeof(Option<Compact>) == sizeof(Compact));
+  STATIC_CHECK(Compact::IndexOf<Large> == 2);
+
+  SECTION("access") {
+    Compact value{Large{}};
+    REQUIRE(value.is<Large>());
+
+    value.as<Large>().unwrap().data[3] = 42;
+    CHECK(std::as_const(value).as<Large>().is_some_and([](const Large& large) { return large.data[3] == 42; }));
+    CHECK(value.as<i32>().is_none());
+
+    const u64 found{value.match(
+      [](const i32) -> u64 { return 0; },
+      [](const String&) -> u64 { return 1; },
+      [](const Large& large) { return large.data[3]; }
+    )};
+    CHECK(found == 42);
+
+    value = String{"small"};
+    CHECK(value.get_index() == Compact::IndexOf<String>);
+    CHECK(value.as<String>().is_some_and([](const String& s) { return s == "small"; }));
+
+    value.emplace<Large>();
+    CHECK(value.is<Large>());
+  }
+
+  SECTION("copy & move") {
+    const Compact original{Compact::from<Large>(Large{{7}})};
+    Compact copy{original};
+
+    copy.as<Large>().unwrap().data[0] = 8;
+    CHECK(original.as<Large>().unwrap().data[0] == 7);
+    CHECK(copy.as<Large>().unwrap().data[0] == 8);
+
+    Option<Large> moved{crab::move(copy).as<Large>()};
+    CHECK(moved.is_some_and([](const Large& large) { return large.data[0] == 8; }));
+    CHECK_FALSE(copy.is_valid());
+
+    CompactAnyOf<8, MoveOnly, Large> move_only{MoveOnly{"name"}};
+    const String name{crab::move(move_only).visit(crab::cases{
+      [](MoveOnly m) { return String{m.get_name()}; },
+      [](Large) { return String{}; },
+    })};
+    CHECK(name == "name");
+  }
+}
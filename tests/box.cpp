@@ -1,5 +1,7 @@
+#include <array>
 #include <catch2/catch_test_macros.hpp>
 #include <memory>
+#include <memory_resource>
 #include <crab/preamble.hpp>
 #include <utility>
 #include <crab/opt/Option.hpp>
@@ -104,3 +106,244 @@ TEST_CASE("Box Option Niche Optimization") {
   opt = crab::none;
   CHECK(opt.is_none());
 }
+
+TEST_CASE("Box<T[]>", "[box]") {
+  Box<u32[]> values{crab::make_box<u32[]>(8)};
+
+  REQUIRE(values.size() == 8);
+  REQUIRE_FALSE(values.is_empty());
+
+  for (const u32 value: values) {
+    REQUIRE(value == 0);
+  }
+
+  for (usize i = 0; i < values.size(); i++) {
+    values[i] = static_cast<u32>(i);
+  }
+
+  const std::span<const u32> view = values.as_span();
+  REQUIRE(view.size() == 8);
+  REQUIRE(view[7] == 7);
+
+  Box<u32[]> cloned{values.clone()};
+  REQUIRE(cloned.as_ptr() != values.as_ptr());
+  REQUIRE(cloned[3] == 3);
+
+  Box<String[]> strings{Box<String[]>::copy_from(std::array<String, 2>{"a", "b"})};
+  REQUIRE(strings[1] == "b");
+
+  Option<Box<String[]>> opt{std::move(strings)};
+  STATIC_CHECK(sizeof(Option<Box<String[]>>) == sizeof(Box<String[]>));
+  REQUIRE(opt.is_some());
+  REQUIRE(opt.get().size() == 2);
+
+  opt = crab::none;
+  REQUIRE(opt.is_none());
+
+  Box<u32[]> empty{crab::make_box<u32[]>(0)};
+  REQUIRE(empty.is_empty());
+  REQUIRE(empty.as_span().empty());
+}
+
+TEST_CASE("Box allocators", "[box]") {
+  SECTION("Stateless") {
+    using Alloc = std::allocator<String>;
+
+    STATIC_CHECK(sizeof(Box<String, Alloc>) == sizeof(String*));
+    STATIC_CHECK(sizeof(Box<String[], std::allocator<String>>) == sizeof(Box<String[]>));
+    STATIC_CHECK(sizeof(Option<Box<String, Alloc>>) == sizeof(Box<String, Alloc>));
+
+    Box<String, Alloc> boxed{crab::make_box_in<String>(Alloc{}, "stateless")};
+    REQUIRE(*boxed == "stateless");
+
+    Box<String, Alloc> cloned{boxed.clone()};
+    REQUIRE(cloned.as_ptr() != boxed.as_ptr());
+    REQUIRE(*cloned == "stateless");
+
+    Option<Box<String, Alloc>> opt{std::move(boxed)};
+    REQUIRE(opt.is_some());
+    opt = crab::none;
+    REQUIRE(opt.is_none());
+  }
+
+  SECTION("Stateful") {
+    AllocationCount count;
+
+    {
+      Box<String, CountingAllocator<String>> boxed{
+        crab::make_box_in<String>(CountingAllocator<String>{count}, "counted"),
+      };
+      REQUIRE(count.live() == 1);
+
+      Box<String, CountingAllocator<String>> moved{std::move(boxed)};
+      REQUIRE(count.live() == 1);
+
+      moved = moved.clone();
+      REQUIRE(count.allocations == 2);
+      REQUIRE(count.live() == 1);
+      REQUIRE(moved.allocator().count == &count);
+
+      Box<u32[], CountingAllocator<u32>> values{crab::make_box_in<u32[]>(CountingAllocator<u32>{count}, 4)};
+      REQUIRE(values.size() == 4);
+      REQUIRE(values[3] == 0);
+      REQUIRE(count.live() == 2);
+    }
+
+    REQUIRE(count.live() == 0);
+  }
+
+  SECTION("Arena") {
+    std::array<std::byte, 256> buffer{};
+    std::pmr::monotonic_buffer_resource arena{buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+
+    using Alloc = std::pmr::polymorphic_allocator<>;
+
+    Box<u64, Alloc> value{crab::make_box_in<u64>(Alloc{&arena}, 42u)};
+    REQUIRE(*value == 42);
+
+    const auto* const address{reinterpret_cast<const std::byte*>(value.as_ptr())};
+    REQUIRE(address >= buffer.data());
+    REQUIRE(address < buffer.data() + buffer.size());
+
+    // polymorphic allocators cannot be assigned, so the box has to replace its own
+    value = crab::make_box_in<u64>(Alloc{&arena}, 10u);
+    REQUIRE(*value == 10);
+
+    Option<Box<u64, Alloc>> opt{std::move(value)};
+    REQUIRE(opt.get().allocator().resource() == &arena);
+  }
+}
+
+namespace {
+  struct Shape {
+    Shape() = default;
+    Shape(const Shape&) = default;
+    Shape(Shape&&) noexcept = default;
+    auto operator=(const Shape&) -> Shape& = default;
+    auto operator=(Shape&&) noexcept -> Shape& = default;
+    virtual ~Shape() = default;
+
+    [[nodiscard]] virtual auto area() const -> f64 = 0;
+  };
+
+  struct Tagged {
+    u32 tag{7};
+  };
+
+  /// Counts how many live instances there are, so that leaks / double drops show up
+  struct Square final : Tagged, Shape {
+    explicit Square(f64 side, usize& alive): side{side}, alive{&alive} {
+      (*this->alive)++;
+    }
+
+    Square(Square&& from) noexcept: Tagged{from}, side{from.side}, alive{from.alive} {
+      (*alive)++;
+    }
+
+    Square(const Square&) = delete;
+    auto operator=(const Square&) -> Square& = delete;
+    auto operator=(Square&&) -> Square& = delete;
+
+    ~Square() override {
+      (*alive)--;
+    }
+
+    [[nodiscard]] auto area() const -> f64 override {
+      return side * side;
+    }
+
+    f64 side;
+    usize* alive;
+  };
+
+  struct Large final : Shape {
+    [[nodiscard]] auto area() const -> f64 override {
+      return data[0];
+    }
+
+    std::array<f64, 16> data{3.0};
+  };
+}
+
+TEST_CASE("InlineBox", "[box]") {
+  usize alive{0};
+
+  SECTION("Inline & Heap") {
+    InlineBox<Shape, 64> square{crab::make_inline_box<Shape, 64, Square>(2.0, alive)};
+    REQUIRE(square.is_inline());
+    REQUIRE(square->area() == 4.0);
+    REQUIRE(alive == 1);
+
+    InlineBox<Shape, 64> large{crab::make_inline_box<Shape, 64, Large>()};
+    REQUIRE_FALSE(large.is_inline());
+    REQUIRE(large->area() == 3.0);
+
+    STATIC_CHECK(InlineBox<Shape, 64>::fits_inline<Square>);
+    STATIC_CHECK_FALSE(InlineBox<Shape, 64>::fits_inline<Large>);
+
+    InlineBox<Shape, 64> from_box{crab::make_box<Square>(3.0, alive)};
+    REQUIRE_FALSE(from_box.is_inline());
+    REQUIRE(from_box->area() == 9.0);
+    REQUIRE(alive == 2);
+  }
+
+  SECTION("Moving") {
+    {
+      InlineBox<Shape, 64> a{crab::make_inline_box<Shape, 64, Square>(2.0, alive)};
+      InlineBox<Shape, 64> b{std::move(a)};
+      REQUIRE(alive == 1);
+      REQUIRE(b->area() == 4.0);
+      REQUIRE(b.downcast<Square>().get().tag == 7);
+      CHECK_THROWS(a.as_ptr());
+
+      InlineBox<Shape, 64> c{crab::make_inline_box<Shape, 64, Square>(5.0, alive)};
+      REQUIRE(alive == 2);
+
+      c = std::move(b);
+      REQUIRE(alive == 1);
+      REQUIRE(c->area() == 4.0);
+
+      // moving an already moved-from box leaves the target empty
+      b = std::move(a);
+      CHECK_THROWS(b.as_ptr());
+
+      InlineBox<Shape, 64> large{crab::make_inline_box<Shape, 64, Large>()};
+      const Shape* const address{large.as_ptr()};
+      c = std::move(large);
+      REQUIRE(alive == 0);
+      REQUIRE(c.as_ptr() == address);
+    }
+
+    REQUIRE(alive == 0);
+  }
+
+  SECTION("Upcasting") {
+    {
+      InlineBox<Square, 64> square{InlineBox<Square, 64>::make(2.0, alive)};
+      REQUIRE(square->tag == 7);
+
+      InlineBox<Shape, 96> shape{std::move(square)};
+      REQUIRE(shape.is_inline());
+      REQUIRE(shape->area() == 4.0);
+      REQUIRE(shape.upcast<Shape>().area() == 4.0);
+      REQUIRE(alive == 1);
+
+      REQUIRE(shape.downcast<Square>().is_some());
+      REQUIRE(shape.downcast<Large>().is_none());
+    }
+
+    REQUIRE(alive == 0);
+  }
+
+  SECTION("Option Niche") {
+    STATIC_CHECK(sizeof(Option<InlineBox<Shape, 64>>) == sizeof(InlineBox<Shape, 64>));
+
+    Option<InlineBox<Shape, 64>> opt{crab::make_inline_box<Shape, 64, Square>(2.0, alive)};
+    REQUIRE(opt.is_some());
+    REQUIRE(opt.get()->area() == 4.0);
+
+    opt = crab::none;
+    REQUIRE(opt.is_none());
+    REQUIRE(alive == 0);
+  }
+}
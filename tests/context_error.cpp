@@ -0,0 +1,110 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <crab/preamble.hpp>
+
+namespace {
+  enum class ParseError : i32 { Empty, NotDigit };
+
+  struct ParseErrorCategory final : crab::ErrorCategory {
+    [[nodiscard]] auto name() const -> StringView override {
+      return "parse";
+    }
+
+    [[nodiscard]] auto message(const i32 value) const -> StringView override {
+      return static_cast<ParseError>(value) == ParseError::Empty ? "empty input" : "expected a digit";
+    }
+  };
+
+  constexpr ParseErrorCategory parse_error_category;
+
+  auto parse_digit(const char c) -> Result<u32, ErrorCode> {
+    if (c < '0' or c > '9') {
+      return ErrorCode{parse_error_category, ParseError::NotDigit};
+    }
+    return static_cast<u32>(c - '0');
+  }
+
+  auto parse_pair(const char a, const char b) -> Result<u32, ContextError<ErrorCode>> {
+    Result<u32, ContextError<ErrorCode>> first{parse_digit(a).context("parsing the first digit")};
+    if (first.is_err()) {
+      return first;
+    }
+
+    Result<u32, ContextError<ErrorCode>> second{parse_digit(b).context("parsing the second digit")};
+    if (second.is_err()) {
+      return second;
+    }
+
+    return crab::move(first).unwrap() * 10 + crab::move(second).unwrap();
+  }
+}
+
+TEST_CASE("StaticStr", "[str]") {
+  constexpr StaticStr empty;
+  STATIC_CHECK(empty.view().empty());
+
+  constexpr StaticStr context{"reading a file"};
+  STATIC_CHECK(context.view() == "reading a file");
+  STATIC_CHECK(context == StaticStr{"reading a file"});
+  STATIC_CHECK(sizeof(StaticStr) == sizeof(const char*));
+
+  CHECK(fmt::format("{}", context) == "reading a file");
+  CHECK(StaticStr::from_raw(unsafe, context.c_str()).view() == "reading a file");
+}
+
+TEST_CASE("ContextError", "[result]") {
+  SECTION("Ok values are passed through") {
+    Result<u32, ContextError<ErrorCode>> result{parse_digit('4').context("parsing a digit")};
+    REQUIRE(result.is_ok());
+    CHECK(crab::move(result).unwrap() == 4);
+
+    CHECK(parse_pair('1', '2').get() == 12);
+  }
+
+  SECTION("Frames") {
+    Result<u32, ContextError<ErrorCode>> result{parse_pair('1', 'x').context("reading the header")};
+    REQUIRE(result.is_err());
+
+    const ContextError<ErrorCode>& error{result.get_err()};
+    CHECK(error.get() == ErrorCode{parse_error_category, ParseError::NotDigit});
+    REQUIRE(error.frame_count() == 2);
+    CHECK(error.frame(0) == StaticStr{"reading the header"});
+    CHECK(error.frame(1) == StaticStr{"parsing the second digit"});
+    CHECK_THROWS(error.frame(2));
+
+    CHECK(fmt::format("{}", error) == "reading the header: parsing the second digit: expected a digit (parse:1)");
+    CHECK(
+      fmt::format("{}", result) == "Err(reading the header: parsing the second digit: expected a digit (parse:1))"
+    );
+  }
+
+  SECTION("Lazy context") {
+    bool called{false};
+    const auto make_context = [&called]() -> StaticStr {
+      called = true;
+      return "parsing a digit";
+    };
+
+    CHECK(parse_digit('4').with_context(make_context).is_ok());
+    CHECK_FALSE(called);
+
+    const Result<u32, ContextError<ErrorCode>> result{parse_digit('x').with_context(make_context)};
+    CHECK(called);
+    CHECK(fmt::format("{}", result) == "Err(parsing a digit: expected a digit (parse:1))");
+  }
+
+  SECTION("Bounded frames") {
+    Result<u32, ContextError<ErrorCode>> result{parse_digit('x').context("1")};
+    for (usize i = 0; i < 5; i++) {
+      result = crab::move(result).context("outer");
+    }
+    result = crab::move(result).context("outermost");
+
+    const ContextError<ErrorCode>& error{result.get_err()};
+    CHECK(error.frame_count() == ContextError<ErrorCode>::MaxFrames);
+    CHECK(error.total_frames() == 7);
+    CHECK(fmt::format("{}", error) == "outermost: outer: outer: outer: (3 more): expected a digit (parse:1)");
+
+    CHECK(crab::move(result).unwrap_err().into_inner() == ErrorCode{parse_error_category, ParseError::NotDigit});
+  }
+}
@@ -0,0 +1,202 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <crab/preamble.hpp>
+
+#include "crab/opt/coroutine.hpp"
+#include "crab/result/coroutine.hpp"
+
+namespace {
+  enum class ParseError : u8 { Empty, NotDigit, Overflow };
+
+  /// Wider error that ParseError converts into
+  struct ConfigError {
+    // NOLINTNEXTLINE(*explicit*)
+    ConfigError(const ParseError error): error{error} {}
+
+    ParseError error;
+  };
+
+  auto parse_digit(const char c) -> Result<u32, ParseError> {
+    if (c < '0' or c > '9') {
+      return ParseError::NotDigit;
+    }
+    return static_cast<u32>(c - '0');
+  }
+
+  auto parse_number(const StringView text) -> Result<u32, ParseError> {
+    if (text.empty()) {
+      co_return ParseError::Empty;
+    }
+
+    u32 number{0};
+    for (const char c: text) {
+      number = number * 10 + co_await parse_digit(c);
+    }
+
+    if (number > 255) {
+      co_return crab::err(ParseError::Overflow);
+    }
+
+    co_return number;
+  }
+
+  auto parse_pair(const StringView left, const StringView right) -> Result<std::pair<u32, u32>, ConfigError> {
+    const u32 first{co_await parse_number(left)};
+    const u32 second{co_await parse_number(right)};
+    co_return std::pair{first, second};
+  }
+
+  auto parse_boxed(const StringView text) -> Result<Box<u32>, String> {
+    co_return crab::make_box<u32>(co_await parse_number(text).map_err([](ParseError) { return String{"bad"}; }));
+  }
+
+  auto find(const std::span<const u32> values, const u32 value) -> Option<usize> {
+    for (usize i = 0; i < values.size(); i++) {
+      if (values[i] == value) {
+        return i;
+      }
+    }
+    return crab::none;
+  }
+
+  auto find_both(const std::span<const u32> values, const u32 a, const u32 b) -> Option<usize> {
+    const usize first{co_await find(values, a)};
+    const usize second{co_await find(values, b)};
+    co_return first + second;
+  }
+
+  auto find_ref(std::span<u32> values, const u32 value) -> Option<u32&> {
+    co_return values[co_await find(values, value)];
+  }
+
+  auto throws(const bool should_throw) -> Result<u32, ParseError> {
+    const u32 value{co_await parse_number("12")};
+    if (should_throw) {
+      throw std::runtime_error{"thrown"};
+    }
+    co_return value;
+  }
+
+  /// Counts how many are alive, to check that the locals of a coroutine's frame are destroyed exactly once
+  struct Tracked {
+    explicit Tracked(usize& alive): alive{&alive} {
+      (*this->alive)++;
+    }
+
+    Tracked(const Tracked&) = delete;
+
+    auto operator=(const Tracked&) -> Tracked& = delete;
+
+    ~Tracked() {
+      (*alive)--;
+    }
+
+    usize* alive;
+  };
+
+  enum class ThrowAt : u8 { Never, Start, AfterAwait, AfterEarlyReturn };
+
+  auto tracked_result(usize& alive, const ThrowAt at, const StringView text) -> Result<u32, ParseError> {
+    const Tracked tracked{alive};
+    if (at == ThrowAt::Start) {
+      throw std::runtime_error{"start"};
+    }
+
+    const u32 value{co_await parse_number(text)};
+    if (at == ThrowAt::AfterAwait) {
+      throw std::runtime_error{"after await"};
+    }
+    co_return value;
+  }
+
+  auto tracked_option(usize& alive, const bool should_throw, const std::span<const u32> values) -> Option<usize> {
+    const Tracked tracked{alive};
+    const usize index{co_await find(values, 6)};
+    if (should_throw) {
+      throw std::runtime_error{"option"};
+    }
+    co_return index;
+  }
+}
+
+TEST_CASE("Coroutines (Result)", "[result][coroutine]") {
+  SECTION("returns the value") {
+    REQUIRE(parse_number("42").get() == 42);
+    REQUIRE(parse_number("7").get() == 7);
+  }
+
+  SECTION("returns early with the error") {
+    REQUIRE(parse_number("").get_err() == ParseError::Empty);
+    REQUIRE(parse_number("4x2").get_err() == ParseError::NotDigit);
+    REQUIRE(parse_number("999").get_err() == ParseError::Overflow);
+  }
+
+  SECTION("converts the error") {
+    const auto pair{parse_pair("1", "2")};
+    REQUIRE(pair.is_ok());
+    CHECK(pair.get().first == 1);
+    CHECK(pair.get().second == 2);
+
+    REQUIRE(parse_pair("1", "x").get_err().error == ParseError::NotDigit);
+    REQUIRE(parse_pair("", "2").get_err().error == ParseError::Empty);
+  }
+
+  SECTION("move only values") {
+    REQUIRE(*parse_boxed("12").get() == 12);
+    REQUIRE(parse_boxed("a").get_err() == "bad");
+  }
+
+  SECTION("exceptions pass through") {
+    REQUIRE(throws(false).get() == 12);
+    REQUIRE_THROWS_AS(throws(true), std::runtime_error);
+  }
+
+  SECTION("frames are destroyed once, whether the coroutine returns, returns early or throws") {
+    usize alive{0};
+
+    REQUIRE(tracked_result(alive, ThrowAt::Never, "12").get() == 12);
+    REQUIRE(alive == 0);
+
+    REQUIRE(tracked_result(alive, ThrowAt::Never, "x").get_err() == ParseError::NotDigit);
+    REQUIRE(alive == 0);
+
+    REQUIRE_THROWS_WITH(tracked_result(alive, ThrowAt::Start, "12"), "start");
+    REQUIRE(alive == 0);
+
+    REQUIRE_THROWS_WITH(tracked_result(alive, ThrowAt::AfterAwait, "12"), "after await");
+    REQUIRE(alive == 0);
+
+    // returns early before reaching the throw
+    REQUIRE(tracked_result(alive, ThrowAt::AfterAwait, "x").get_err() == ParseError::NotDigit);
+    REQUIRE(alive == 0);
+
+    // the result of a coroutine that threw can be replaced by the next call
+    Result<u32, ParseError> result{ParseError::Empty};
+    REQUIRE_THROWS_AS(result = tracked_result(alive, ThrowAt::AfterAwait, "1"), std::runtime_error);
+    REQUIRE(result.get_err() == ParseError::Empty);
+    result = tracked_result(alive, ThrowAt::Never, "3");
+    REQUIRE(result.get() == 3);
+    REQUIRE(alive == 0);
+  }
+}
+
+TEST_CASE("Coroutines (Option)", "[option][coroutine]") {
+  std::array<u32, 4> values{5, 6, 7, 8};
+
+  REQUIRE(find_both(values, 6, 8) == crab::some(usize{4}));
+  REQUIRE(find_both(values, 6, 9).is_none());
+  REQUIRE(find_both(values, 1, 8).is_none());
+
+  Option<u32&> found{find_ref(values, 7)};
+  REQUIRE(found.is_some());
+  found.get() = 70;
+  CHECK(values[2] == 70);
+
+  REQUIRE(find_ref(values, 7).is_none());
+
+  usize alive{0};
+  REQUIRE(tracked_option(alive, false, values) == crab::some(usize{1}));
+  REQUIRE_THROWS_WITH(tracked_option(alive, true, values), "option");
+  REQUIRE(tracked_option(alive, true, std::array<u32, 1>{1}).is_none());
+  REQUIRE(alive == 0);
+}
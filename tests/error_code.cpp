@@ -0,0 +1,77 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <crab/preamble.hpp>
+
+namespace {
+  enum class ParseError : i32 { Empty, NotDigit };
+
+  struct ParseErrorCategory final : crab::ErrorCategory {
+    [[nodiscard]] auto name() const -> StringView override {
+      return "parse";
+    }
+
+    [[nodiscard]] auto message(const i32 value) const -> StringView override {
+      switch (static_cast<ParseError>(value)) {
+        case ParseError::Empty:    return "empty input";
+        case ParseError::NotDigit: return "expected a digit";
+      }
+      return "unknown";
+    }
+  };
+
+  constexpr ParseErrorCategory parse_error_category;
+
+  auto parse_digit(const char c) -> Result<u32, ErrorCode> {
+    if (c < '0' or c > '9') {
+      return ErrorCode{parse_error_category, ParseError::NotDigit, "reading a digit"};
+    }
+    return static_cast<u32>(c - '0');
+  }
+}
+
+TEST_CASE("ErrorCode", "[result]") {
+  SECTION("Value & category") {
+    const ErrorCode code{parse_error_category, ParseError::Empty};
+
+    CHECK(&code.category() == &parse_error_category);
+    CHECK(code.value() == 0);
+    CHECK(code.message() == "empty input");
+    CHECK(code.context().is_none());
+
+    CHECK(code == ErrorCode{parse_error_category, 0});
+    CHECK(code == code.with_context("parsing a header"));
+    CHECK_FALSE(code == ErrorCode{parse_error_category, ParseError::NotDigit});
+  }
+
+  SECTION("Formatting") {
+    const ErrorCode code{parse_error_category, ParseError::NotDigit};
+
+    CHECK(fmt::format("{}", code) == "expected a digit (parse:1)");
+    CHECK(code.what() == "expected a digit (parse:1)");
+
+    const ErrorCode with_context{code.with_context("parsing a header")};
+    REQUIRE(with_context.context().is_some());
+    CHECK(with_context.context().get_unchecked(unsafe) == "parsing a header");
+    CHECK(fmt::format("{}", with_context) == "parsing a header: expected a digit (parse:1)");
+  }
+
+  SECTION("In a Result") {
+    CHECK(fmt::format("{}", parse_digit('4')) == "Ok(4)");
+    CHECK(fmt::format("{}", parse_digit('x')) == "Err(reading a digit: expected a digit (parse:1))");
+
+    Result<u32, ErrorCode> result{parse_digit('x')};
+    REQUIRE(result.is_err());
+    CHECK(result.get_err() == ErrorCode{parse_error_category, ParseError::NotDigit});
+
+    result = 7_u32;
+    REQUIRE(result.is_ok());
+    CHECK(result.get() == 7);
+  }
+
+  SECTION("As an IError") {
+    const Box<crab::IError> error{ErrorCode{parse_error_category, ParseError::Empty, "reading a file"}.into_error()};
+
+    CHECK(error->what() == "reading a file: empty input (parse:0)");
+    CHECK(fmt::format("{}", *error) == "reading a file: empty input (parse:0)");
+  }
+}
@@ -11,6 +11,7 @@
 #include <crab/num/range.hpp>
 #include <crab/opt/Option.hpp>
 #include <crab/opt/some.hpp>
+#include <limits>
 #include <utility>
 
 namespace ty = crab::ty;
@@ -30,7 +31,7 @@ TEST_CASE("Option", "Tests for all option methods") {
   SECTION("Constructors & Move Semantics") {
     Option<i32> a, b;
 
-    auto c = a and b;
+    [[maybe_unused]] auto c = a and b;
 
     // general construction
     asserts::for_types(asserts::common_types, []<typename T>(asserts::type<T>) {
@@ -292,3 +293,77 @@ TEST_CASE("Reference Types", "[option]") {
 
   REQUIRE_NOTHROW(a.template map<i32>().unwrap() == 11);
 }
+
+namespace {
+  enum class Direction : u8 { North, East, South, West };
+
+  /// Has no niche, so the option keeps a separate flag
+  struct Entity {
+    u32 id;
+    Direction facing;
+  };
+}
+
+template<>
+struct crab::opt::Niche<Direction> : crab::opt::ValueNiche<Direction, Direction{0xFF}> {};
+
+TEST_CASE("Niche Optimisation", "[option]") {
+  SECTION("Sizes") {
+    STATIC_CHECK(sizeof(Option<Direction>) == sizeof(Direction));
+    STATIC_CHECK(sizeof(Option<bool>) == sizeof(bool));
+    STATIC_CHECK(sizeof(Option<float>) == sizeof(float));
+    STATIC_CHECK(sizeof(Option<double>) == sizeof(double));
+    STATIC_CHECK(sizeof(Option<Ref<i32>>) == sizeof(Ref<i32>));
+    STATIC_CHECK(sizeof(Option<RefMut<String>>) == sizeof(RefMut<String>));
+    STATIC_CHECK(sizeof(Option<AnyOf<u32, String>>) == sizeof(AnyOf<u32, String>));
+    STATIC_CHECK(sizeof(Option<Option<u64>>) == sizeof(Option<u64>));
+    STATIC_CHECK(sizeof(Option<Option<Entity>>) == sizeof(Option<Entity>));
+
+    STATIC_CHECK_FALSE(crab::opt::has_niche<Entity>);
+    STATIC_CHECK_FALSE(crab::opt::has_niche<u64>);
+  }
+
+  SECTION("Values") {
+    Option<Direction> direction{Direction::West};
+    REQUIRE(direction.is_some());
+    REQUIRE(direction.get() == Direction::West);
+
+    direction = crab::none;
+    REQUIRE(direction.is_none());
+
+    Option<bool> flag{false};
+    REQUIRE(flag.is_some());
+    REQUIRE_FALSE(flag.get());
+
+    Option<double> nan{std::numeric_limits<double>::quiet_NaN()};
+    REQUIRE(nan.is_some());
+    REQUIRE(Option<double>{}.is_none());
+  }
+
+  SECTION("Moving") {
+    Option<AnyOf<u32, String>> any{AnyOf<u32, String>{String{"crab"}}};
+    REQUIRE(any.is_some());
+
+    Option moved{std::move(any)};
+    REQUIRE(moved.get().as<String>().get() == "crab");
+    REQUIRE(any.is_none());
+
+    any = std::move(moved);
+    REQUIRE(any.is_some());
+    REQUIRE(moved.is_none());
+  }
+
+  SECTION("Nested") {
+    Option<Option<u64>> none{};
+    Option<Option<u64>> some_none{Option<u64>{}};
+    Option<Option<u64>> some_some{Option<u64>{10}};
+
+    REQUIRE(none.is_none());
+    REQUIRE(some_none.is_some());
+    REQUIRE(some_none.get().is_none());
+    REQUIRE(some_some.get().get() == 10);
+
+    REQUIRE(std::move(some_some).flatten() == crab::some(u64{10}));
+    REQUIRE(some_some.is_none());
+  }
+}
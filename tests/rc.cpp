@@ -2,10 +2,29 @@
 // Created by bishan_ on 5/20/24.
 //
 
+#include <array>
 #include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <thread>
 #include <utility>
+#include <vector>
 #include "test_types.hpp"
 
+namespace {
+  struct DropCounter : Base {
+    explicit DropCounter(usize& drops): drops{drops} {}
+
+    DropCounter(const DropCounter&) = delete;
+    auto operator=(const DropCounter&) -> DropCounter& = delete;
+
+    ~DropCounter() override {
+      drops++;
+    }
+
+    usize& drops;
+  };
+}
+
 TEST_CASE("Rc/RcMut") {
   SECTION("move") {
     SECTION("Rc") {
@@ -67,6 +86,101 @@ TEST_CASE("Rc/RcMut") {
     }
   }
 
+  SECTION("Drop") {
+    usize drops{0};
+
+    SECTION("make_rc") {
+      {
+        Rc<DropCounter> rc = crab::make_rc<DropCounter>(drops);
+        Rc<DropCounter> other = rc;
+        REQUIRE(rc.get_ref_count() == 2);
+        REQUIRE(drops == 0);
+      }
+      REQUIRE(drops == 1);
+    }
+
+    SECTION("make_rc_mut") {
+      {
+        RcMut<DropCounter> rc = crab::make_rc_mut<DropCounter>(drops);
+        Rc<DropCounter> other = rc;
+        REQUIRE(drops == 0);
+      }
+      REQUIRE(drops == 1);
+    }
+
+    SECTION("From Box") {
+      {
+        Rc<DropCounter> rc = crab::make_box<DropCounter>(drops);
+        RcMut<DropCounter> rc_mut = crab::make_box<DropCounter>(drops);
+        REQUIRE(rc.is_unique());
+        REQUIRE(rc_mut.is_unique());
+      }
+      REQUIRE(drops == 2);
+    }
+
+    SECTION("Pooled counter") {
+      using crab::rc::impl::CounterPool;
+
+      void* const block{CounterPool::allocate(32)};
+      CounterPool::deallocate(block, 32);
+      REQUIRE(CounterPool::allocate(24) == block);
+
+      // blocks can be freed on another thread, which keeps them until it exits
+      std::thread{[block] { CounterPool::deallocate(block, 24); }}.join();
+
+      for (usize i = 0; i < 4; i++) {
+        Rc<DropCounter> rc = crab::make_box<DropCounter>(drops);
+        RcMut<DropCounter> rc_mut = crab::make_box<DropCounter>(drops);
+        REQUIRE(rc.is_unique());
+      }
+      REQUIRE(drops == 8);
+    }
+
+    SECTION("Upcast") {
+      {
+        Rc<Base> rc = crab::make_rc<DropCounter>(drops);
+        RcMut<Base> rc_mut = crab::make_rc_mut<DropCounter>(drops);
+        REQUIRE(drops == 0);
+      }
+      REQUIRE(drops == 2);
+    }
+
+    SECTION("Inline layout") {
+      Rc<u64> rc = crab::make_rc<u64>(42u);
+      RcMut<u64> rc_mut = crab::make_rc_mut<u64>(42u);
+      REQUIRE(*rc == 42);
+      REQUIRE(*rc_mut == 42);
+      REQUIRE(reinterpret_cast<usize>(rc.as_ptr()) % alignof(u64) == 0);
+    }
+  }
+
+  SECTION("Allocator") {
+    AllocationCount count;
+    usize drops{0};
+
+    {
+      Rc<Base> rc = crab::make_rc_in<DropCounter>(CountingAllocator<DropCounter>{count}, drops);
+      RcMut<String> rc_mut = crab::make_rc_mut_in<String>(CountingAllocator<String>{count}, "allocated");
+      REQUIRE(count.live() == 2);
+
+      const Weak<Base> weak = rc.downgrade();
+      rc = crab::make_rc<DropCounter>(drops);
+
+      // the value is dropped with the last strong reference, but the block stays until the weak reference is gone
+      REQUIRE(drops == 1);
+      REQUIRE(count.live() == 2);
+
+      *rc_mut = "changed";
+      REQUIRE(*rc_mut == "changed");
+    }
+
+    REQUIRE(drops == 2);
+    REQUIRE(count.live() == 0);
+
+    using Block = crab::rc::impl::AllocInlineCounter<u64, crab::rc::impl::Counter, std::allocator<u64>>;
+    STATIC_REQUIRE(sizeof(Block) == sizeof(crab::rc::impl::InlineCounter<u64>));
+  }
+
   SECTION("Option Niche Optimisation") {
     using crab::mem::size_of;
 
@@ -74,6 +188,588 @@ TEST_CASE("Rc/RcMut") {
       STATIC_REQUIRE(sizeof(Rc<T>) == sizeof(RcMut<T>));
       STATIC_REQUIRE(sizeof(Rc<T>) == sizeof(Option<Rc<T>>));
       STATIC_REQUIRE(sizeof(RcMut<T>) == sizeof(Option<RcMut<T>>));
+      STATIC_REQUIRE(sizeof(Weak<T>) == sizeof(Option<Weak<T>>));
+    });
+  }
+}
+
+TEST_CASE("Weak") {
+  SECTION("upgrade") {
+    Rc<String> rc = crab::make_rc<String>("some str");
+    Weak<String> weak = rc.downgrade();
+
+    REQUIRE(rc.get_weak_ref_count() == 1);
+    REQUIRE(weak.get_ref_count() == 1);
+    REQUIRE_FALSE(weak.is_expired());
+
+    {
+      Option<Rc<String>> upgraded = weak.upgrade();
+      REQUIRE(upgraded.is_some());
+      REQUIRE(upgraded.get().as_ptr() == rc.as_ptr());
+      REQUIRE(rc.get_ref_count() == 2);
+    }
+
+    REQUIRE(rc.get_ref_count() == 1);
+
+    Weak<String> copy = weak;
+    REQUIRE(rc.get_weak_ref_count() == 2);
+
+    Weak<String> moved = std::move(copy);
+    REQUIRE_FALSE(copy.is_valid());
+    REQUIRE(rc.get_weak_ref_count() == 2);
+  }
+
+  SECTION("Drop") {
+    usize drops = 0;
+
+    Option<Weak<DropCounter>> weak{crab::none};
+
+    {
+      RcMut<DropCounter> rc = crab::make_rc_mut<DropCounter>(drops);
+      weak = rc.downgrade();
+
+      REQUIRE(weak.get().upgrade().is_some());
+      REQUIRE(drops == 0);
+    }
+
+    // the value is dropped with the last strong reference, even though the block is still alive
+    REQUIRE(drops == 1);
+    REQUIRE(weak.get().is_expired());
+    REQUIRE(weak.get().upgrade().is_none());
+    REQUIRE(weak.get().get_weak_ref_count() == 1);
+
+    weak = crab::none;
+    REQUIRE(drops == 1);
+  }
+
+  SECTION("Self reference") {
+    struct Node {
+      Option<Weak<Node>> self{crab::none};
+      usize& drops;
+
+      explicit Node(usize& drops): drops{drops} {}
+
+      Node(const Node&) = delete;
+      auto operator=(const Node&) -> Node& = delete;
+
+      ~Node() {
+        drops++;
+      }
+    };
+
+    usize drops = 0;
+
+    {
+      RcMut<Node> node = crab::make_rc_mut<Node>(drops);
+      node->self = node.downgrade();
+
+      REQUIRE(node.get_weak_ref_count() == 1);
+    }
+
+    // the node holds the last weak reference to itself, so dropping it must not free the block mid-destructor
+    REQUIRE(drops == 1);
+  }
+}
+
+TEST_CASE("Arc/ArcMut") {
+  SECTION("move") {
+    Arc<String> arc = crab::make_arc<String>("some str");
+
+    REQUIRE(arc.is_unique());
+    REQUIRE(*arc == "some str");
+
+    Arc<String> other = std::move(arc);
+    REQUIRE(other.is_unique());
+    REQUIRE(not arc.is_valid());
+  }
+
+  SECTION("Drop") {
+    usize drops{0};
+
+    {
+      Arc<Base> arc = crab::make_arc<DropCounter>(drops);
+      ArcMut<DropCounter> arc_mut = crab::make_box<DropCounter>(drops);
+      Arc<DropCounter> from_mut = arc_mut;
+
+      REQUIRE(arc_mut.get_ref_count() == 2);
+      REQUIRE(drops == 0);
+    }
+
+    REQUIRE(drops == 2);
+  }
+
+  SECTION("Box conversion") {
+    ArcMut<String> arc = crab::make_box<String>("boxed");
+
+    {
+      const Arc<String> shared = arc;
+
+      arc = std::move(arc).into_box().unwrap_err();
+      REQUIRE(arc.get_ref_count() == 2);
+    }
+
+    Box<String> box = std::move(arc).into_box().unwrap();
+    REQUIRE(*box == "boxed");
+    REQUIRE(not arc.is_valid());
+  }
+
+  SECTION("Shared across threads") {
+    constexpr usize thread_count{8};
+    constexpr usize iterations{10'000};
+
+    usize drops{0};
+
+    {
+      const Arc<DropCounter> arc = crab::make_arc<DropCounter>(drops);
+
+      std::vector<std::thread> threads;
+      for (usize i = 0; i < thread_count; i++) {
+        threads.emplace_back([arc] {
+          for (usize j = 0; j < iterations; j++) {
+            const Arc<DropCounter> clone = arc.clone();
+            crab::discard(clone);
+          }
+        });
+      }
+
+      for (std::thread& thread: threads) {
+        thread.join();
+      }
+
+      REQUIRE(arc.is_unique());
+      REQUIRE(drops == 0);
+    }
+
+    REQUIRE(drops == 1);
+  }
+
+  SECTION("Option Niche Optimisation") {
+    asserts::for_types(asserts::common_types, []<typename T>(asserts::type<T>) {
+      STATIC_REQUIRE(sizeof(Arc<T>) == sizeof(ArcMut<T>));
+      STATIC_REQUIRE(sizeof(Arc<T>) == sizeof(Option<Arc<T>>));
+      STATIC_REQUIRE(sizeof(ArcMut<T>) == sizeof(Option<ArcMut<T>>));
     });
   }
 }
+
+TEST_CASE("Rc unique ownership") {
+  using Tracked = MoveTracker<Copyable>;
+
+  SECTION("make_mut") {
+    SECTION("unique") {
+      RcMut<MoveCount> count{crab::make_rc_mut<MoveCount>()};
+      Rc<Tracked> rc = crab::make_rc<Tracked>(Tracked::from(count));
+      const Tracked* const original = rc.as_ptr();
+      *count = {};
+
+      rc.make_mut().inner().set_name("changed");
+
+      // mutated in place, no copy made
+      REQUIRE(rc.as_ptr() == original);
+      REQUIRE(rc->inner().get_name() == "changed");
+      count->valid({.moves = 0, .copies = 0});
+    }
+
+    SECTION("shared") {
+      RcMut<MoveCount> count{crab::make_rc_mut<MoveCount>()};
+      Rc<Tracked> rc = crab::make_rc<Tracked>(Tracked::from(count));
+      Rc<Tracked> other = rc.clone();
+      *count = {};
+
+      rc.make_mut().inner().set_name("changed");
+
+      REQUIRE(rc.as_ptr() != other.as_ptr());
+      REQUIRE(rc.is_unique());
+      REQUIRE(other.is_unique());
+      REQUIRE(rc->inner().get_name() == "changed");
+      REQUIRE(other->inner().get_name().empty());
+      count->valid({.moves = 0, .copies = 1});
+    }
+
+    SECTION("weak") {
+      RcMut<MoveCount> count{crab::make_rc_mut<MoveCount>()};
+      Rc<Tracked> rc = crab::make_rc<Tracked>(Tracked::from(count));
+      Weak<Tracked> weak = rc.downgrade();
+      *count = {};
+
+      rc.make_mut().inner().set_name("changed");
+
+      // the value is moved out from under the weak reference rather than copied
+      REQUIRE(weak.is_expired());
+      REQUIRE(rc.get_weak_ref_count() == 0);
+      REQUIRE(rc->inner().get_name() == "changed");
+      count->valid({.moves = 1, .copies = 0});
+    }
+  }
+
+  SECTION("try_unwrap") {
+    RcMut<MoveCount> count{crab::make_rc_mut<MoveCount>()};
+    Rc<Tracked> rc = crab::make_rc<Tracked>(Tracked::from(count));
+    *count = {};
+
+    {
+      Rc<Tracked> other = rc.clone();
+      Result<Tracked, Rc<Tracked>> result = std::move(other).try_unwrap();
+      REQUIRE(result.is_err());
+      REQUIRE(rc.get_ref_count() == 2);
+    }
+
+    REQUIRE(rc.is_unique());
+    Weak<Tracked> weak = rc.downgrade();
+
+    REQUIRE(std::move(rc).try_unwrap().is_ok());
+    REQUIRE_FALSE(rc.is_valid());
+    REQUIRE(weak.is_expired());
+    REQUIRE(count->copies == 0);
+  }
+
+  SECTION("into_inner") {
+    Rc<String> rc = crab::make_rc<String>("some str");
+    Rc<String> other = rc.clone();
+
+    REQUIRE(std::move(other).into_inner().is_none());
+    REQUIRE(rc.is_unique());
+
+    Option<String> inner = std::move(rc).into_inner();
+    REQUIRE(inner.is_some());
+    REQUIRE(inner.get() == "some str");
+  }
+}
+
+TEST_CASE("RcSlice") {
+  SECTION("make_rc_slice") {
+    const std::array<String, 3> values{"a", "b", "c"};
+    RcSlice<String> slice = crab::make_rc_slice<String>(values);
+
+    REQUIRE(slice.size() == 3);
+    REQUIRE(slice[1] == "b");
+    REQUIRE(slice.is_unique());
+
+    RcSlice<String> other = slice.clone();
+    REQUIRE(slice.get_ref_count() == 2);
+    REQUIRE(other.as_span().data() == slice.as_span().data());
+
+    usize count = 0;
+    for (const String& value: other) {
+      REQUIRE(value == values.at(count++));
+    }
+    REQUIRE(count == 3);
+
+    RcSlice<u32> filled = crab::make_rc_slice<u32>(4, 7);
+    REQUIRE(filled.size() == 4);
+    REQUIRE(filled[3] == 7);
+
+    RcSlice<u32> empty = crab::make_rc_slice<u32>(std::span<const u32>{});
+    REQUIRE(empty.is_empty());
+  }
+
+  SECTION("From Box") {
+    Box<String[]> box{crab::make_box<String[]>(2)};
+    box[0] = "first";
+    box[1] = "second";
+
+    RcSlice<String> slice{std::move(box)};
+    REQUIRE(slice.size() == 2);
+    REQUIRE(slice[0] == "first");
+    REQUIRE(slice[1] == "second");
+  }
+
+  SECTION("Layout") {
+    // the elements live in the same allocation, directly after the counter & length
+    RcSlice<u64> slice = crab::make_rc_slice<u64>(16, 1);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(slice.as_span().data()) % alignof(u64) == 0);
+
+    STATIC_REQUIRE(sizeof(RcSlice<u64>) == sizeof(void*));
+    STATIC_REQUIRE(sizeof(Option<RcSlice<u64>>) == sizeof(RcSlice<u64>));
+
+    Option<RcSlice<u64>> opt{slice};
+    REQUIRE(slice.get_ref_count() == 2);
+    opt = crab::none;
+    REQUIRE(slice.is_unique());
+  }
+}
+
+namespace {
+  struct Node : crab::rc::Intrusive {
+    explicit Node(usize& drops): drops{drops} {}
+
+    Node(const Node&) = default;
+    auto operator=(const Node&) -> Node& = delete;
+
+    virtual ~Node() {
+      drops++;
+    }
+
+    Option<IntrusiveRc<Node>> next{crab::none};
+    usize& drops;
+  };
+
+  struct LeafNode final : Node {
+    using Node::Node;
+  };
+
+  struct SharedNode final : crab::rc::AtomicIntrusive {
+    u32 value{0};
+  };
+}
+
+TEST_CASE("IntrusiveRc") {
+  SECTION("Drop") {
+    usize drops = 0;
+
+    {
+      IntrusiveRc<Node> head = crab::make_intrusive<Node>(drops);
+      REQUIRE(head.is_unique());
+
+      head->next = crab::make_intrusive<Node>(drops);
+      IntrusiveRc<Node> second = head->next.get();
+      REQUIRE(second.get_ref_count() == 2);
+
+      // copying the object does not copy its count
+      Node copy{*head};
+      REQUIRE(head.is_unique());
+    }
+
+    REQUIRE(drops == 3);
+  }
+
+  SECTION("Raw round trip") {
+    usize drops = 0;
+
+    IntrusiveRc<Node> rc = crab::make_intrusive<Node>(drops);
+    Node* raw = rc.clone().into_raw();
+    REQUIRE(rc.get_ref_count() == 2);
+
+    // a new reference can be made from any managed raw pointer, the count lives in the object
+    IntrusiveRc<Node> borrowed = IntrusiveRc<Node>::from_owned_unchecked(raw);
+    REQUIRE(rc.get_ref_count() == 3);
+
+    {
+      IntrusiveRc<Node> reclaimed = IntrusiveRc<Node>::from_raw(crab::unsafe, raw);
+      REQUIRE(reclaimed.as_ptr() == rc.as_ptr());
+    }
+
+    REQUIRE(rc.get_ref_count() == 2);
+    REQUIRE(drops == 0);
+  }
+
+  SECTION("Upcast / Downcast") {
+    usize drops = 0;
+
+    {
+      IntrusiveRc<Node> node = crab::make_intrusive<LeafNode>(drops);
+      REQUIRE(node.is_unique());
+
+      Option<IntrusiveRc<LeafNode>> leaf = node.downcast<LeafNode>();
+      REQUIRE(leaf.is_some());
+      REQUIRE(node.get_ref_count() == 2);
+
+      IntrusiveRc<const Node> immutable = leaf.get().upcast<const Node>();
+      REQUIRE(node.get_ref_count() == 3);
+
+      IntrusiveRc<Node> plain = crab::make_intrusive<Node>(drops);
+      REQUIRE(plain.downcast<LeafNode>().is_none());
+      REQUIRE(plain.is_unique());
+    }
+
+    REQUIRE(drops == 2);
+  }
+
+  SECTION("Atomic") {
+    IntrusiveRc<SharedNode> node = crab::make_intrusive<SharedNode>();
+
+    std::vector<std::thread> threads;
+    for (usize i = 0; i < 8; i++) {
+      threads.emplace_back([node] {
+        for (usize j = 0; j < 10'000; j++) {
+          crab::discard(IntrusiveRc<SharedNode>{node});
+        }
+      });
+    }
+
+    for (std::thread& thread: threads) {
+      thread.join();
+    }
+
+    REQUIRE(node.is_unique());
+  }
+
+  SECTION("Layout") {
+    STATIC_REQUIRE(sizeof(IntrusiveRc<Node>) == sizeof(void*));
+    STATIC_REQUIRE(sizeof(Option<IntrusiveRc<Node>>) == sizeof(IntrusiveRc<Node>));
+    STATIC_REQUIRE(sizeof(Option<IntrusiveRc<SharedNode>>) == sizeof(void*));
+  }
+}
+
+TEST_CASE("AtomicArc") {
+  SECTION("load/store") {
+    AtomicArc<String> cell{crab::make_arc<String>("first")};
+
+    Arc<String> first = cell.load();
+    REQUIRE(*first == "first");
+    REQUIRE(first.get_ref_count() == 2);
+
+    cell.store(crab::make_arc<String>("second"));
+    REQUIRE(*cell.load() == "second");
+
+    // the old value lives on for as long as someone still holds it
+    REQUIRE(*first == "first");
+    REQUIRE(first.is_unique());
+
+    Arc<String> previous = cell.exchange(crab::make_arc<String>("third"));
+    REQUIRE(*previous == "second");
+    REQUIRE(previous.is_unique());
+  }
+
+  SECTION("compare_exchange") {
+    AtomicArc<String> cell{crab::make_arc<String>("first")};
+
+    Arc<String> expected = crab::make_arc<String>("first");
+    REQUIRE_FALSE(cell.compare_exchange(expected, crab::make_arc<String>("second")));
+    REQUIRE(expected.as_ptr() == cell.load().as_ptr());
+
+    REQUIRE(cell.compare_exchange(expected, crab::make_arc<String>("second")));
+    REQUIRE(*expected == "first");
+    REQUIRE(*cell.load() == "second");
+  }
+
+  SECTION("Concurrent readers") {
+    struct Snapshot {
+      explicit Snapshot(std::atomic_size_t& drops): drops{drops} {}
+
+      Snapshot(const Snapshot&) = delete;
+      auto operator=(const Snapshot&) -> Snapshot& = delete;
+
+      ~Snapshot() {
+        drops++;
+      }
+
+      std::atomic_size_t& drops;
+    };
+
+    std::atomic_size_t drops{0};
+    AtomicArc<Snapshot> cell{crab::make_arc<Snapshot>(drops)};
+
+    std::atomic_bool running{true};
+    std::atomic_size_t loads{0};
+    std::vector<std::thread> readers;
+
+    for (usize i = 0; i < 4; i++) {
+      readers.emplace_back([&cell, &running, &loads] {
+        while (running.load(std::memory_order_relaxed)) {
+          const Arc<Snapshot> value = cell.load();
+          loads.fetch_add(value.get_ref_count() >= 1 ? 1 : 0, std::memory_order_relaxed);
+        }
+      });
+    }
+
+    constexpr usize stores{200};
+    for (usize i = 0; i < stores; i++) {
+      cell.store(crab::make_arc<Snapshot>(drops));
+    }
+
+    running = false;
+    for (std::thread& reader: readers) {
+      reader.join();
+    }
+
+    REQUIRE(drops == stores);
+    REQUIRE(cell.load().get_ref_count() == 2);
+  }
+}
+
+TEST_CASE("BiasedArc") {
+  SECTION("Owner thread") {
+    usize drops{0};
+
+    {
+      BiasedArc<DropCounter> rc = crab::make_biased_arc<DropCounter>(drops);
+      REQUIRE(rc.is_unique());
+
+      {
+        const BiasedArc<DropCounter> other = rc.clone();
+        REQUIRE(rc.get_ref_count() == 2);
+      }
+
+      REQUIRE(rc.is_unique());
+      REQUIRE(drops == 0);
+    }
+
+    REQUIRE(drops == 1);
+
+    BiasedArc<String> rc = crab::make_biased_arc<String>("biased");
+    REQUIRE(std::move(rc).try_unwrap().is_ok());
+  }
+
+  SECTION("Shared with other threads") {
+    std::atomic_size_t drops{0};
+
+    struct Counted {
+      explicit Counted(std::atomic_size_t& drops): drops{drops} {}
+
+      Counted(const Counted&) = delete;
+      auto operator=(const Counted&) -> Counted& = delete;
+
+      ~Counted() {
+        drops++;
+      }
+
+      std::atomic_size_t& drops;
+    };
+
+    SECTION("Owner drops last") {
+      BiasedArc<Counted> rc = crab::make_biased_arc<Counted>(drops);
+
+      std::atomic_size_t seen{0};
+      std::vector<std::thread> threads;
+
+      for (usize i = 0; i < 4; i++) {
+        threads.emplace_back([shared = rc.clone(), &seen] {
+          for (usize j = 0; j < 1000; j++) {
+            const BiasedArc<Counted> local = shared.clone();
+            seen.fetch_add(local.is_unique() ? 0 : 1, std::memory_order_relaxed);
+          }
+        });
+      }
+
+      for (std::thread& thread: threads) {
+        thread.join();
+      }
+
+      REQUIRE(seen == 4000);
+      REQUIRE(rc.is_unique());
+      REQUIRE(drops == 0);
+    }
+
+    SECTION("Other thread drops last") {
+      std::thread{[moved = crab::make_biased_arc<Counted>(drops)] {
+        const BiasedArc<Counted> local = moved.clone();
+      }}.join();
+
+      // the owner only learns that the last reference is gone on its next update
+      std::atomic_size_t unrelated_drops{0};
+      crab::discard(crab::make_biased_arc<Counted>(unrelated_drops));
+      REQUIRE(drops == 1);
+    }
+
+    SECTION("Owner exits first") {
+      BiasedArc<Counted> outlives_owner = [&drops] {
+        Option<BiasedArc<Counted>> made;
+        std::thread{[&made, &drops] { made = crab::make_biased_arc<Counted>(drops); }}.join();
+        return std::move(made).unwrap();
+      }();
+
+      REQUIRE(outlives_owner.get_ref_count() == 1);
+      REQUIRE(outlives_owner.clone().get_ref_count() == 2);
+      REQUIRE(drops == 0);
+
+      {
+        const BiasedArc<Counted> last = std::move(outlives_owner);
+      }
+
+      REQUIRE(drops == 1);
+    }
+
+    REQUIRE(drops == 1);
+  }
+}
@@ -51,3 +51,93 @@ TEST_CASE("Ref Types") {
 }
 
 struct IncompleteType {};
+
+namespace {
+  // Node -> { Literal, Binary -> { Add } }, numbered in pre-order
+  struct Node : crab::ref::TypeTag {
+    static constexpr crab::ref::TypeRange<Node> crab_type_range{0, 3};
+
+    using TypeTag::TypeTag;
+    Node(const Node&) = delete;
+    Node(Node&&) = delete;
+    auto operator=(const Node&) -> Node& = delete;
+    auto operator=(Node&&) -> Node& = delete;
+    virtual ~Node() = default;
+  };
+
+  struct Literal final : Node {
+    static constexpr crab::ref::TypeRange<Literal> crab_type_range{1, 1};
+
+    explicit Literal(const i32 value): Node{crab_type_range.first}, value{value} {}
+
+    i32 value;
+  };
+
+  struct Binary : Node {
+    static constexpr crab::ref::TypeRange<Binary> crab_type_range{2, 3};
+
+    Binary(): Node{crab_type_range.first} {}
+
+  protected:
+
+    explicit Binary(const crab::ref::TypeId id): Node{id} {}
+  };
+
+  struct Add final : Binary {
+    static constexpr crab::ref::TypeRange<Add> crab_type_range{3, 3};
+
+    Add(): Binary{crab_type_range.first} {}
+  };
+
+  // inherits the range of its parent, so it must fall back to dynamic_cast
+  struct Untagged final : Binary {};
+}
+
+TEST_CASE("Type Identified Casts") {
+  STATIC_REQUIRE(crab::ref::fast_castable<Literal, Node>);
+  STATIC_REQUIRE(crab::ref::fast_castable<Add, Binary>);
+  STATIC_REQUIRE(not crab::ref::fast_castable<Untagged, Node>);
+  STATIC_REQUIRE(not crab::ref::fast_castable<Derived, Base>);
+
+  SECTION("ref::cast") {
+    Literal literal{10};
+    Add add;
+    Node& node{literal};
+
+    REQUIRE(crab::ref::cast<Literal>(node).is_some());
+    REQUIRE(crab::ref::cast<Literal>(node).get().value == 10);
+    REQUIRE(crab::ref::cast<Binary>(node).is_none());
+    REQUIRE(crab::ref::cast<Add>(node).is_none());
+
+    const Node& other{add};
+    REQUIRE(crab::ref::cast<Binary>(other).is_some());
+    REQUIRE(crab::ref::cast<Add>(other).is_some());
+    REQUIRE(crab::ref::cast<Literal>(other).is_none());
+
+    REQUIRE(crab::ref::is<Binary>(other));
+    REQUIRE(crab::ref::is_exact<Add>(other));
+    REQUIRE_FALSE(crab::ref::is_exact<Binary>(other));
+
+    Untagged untagged;
+    Node& fallback{untagged};
+    REQUIRE(crab::ref::cast<Binary>(fallback).is_some());
+    REQUIRE(crab::ref::cast<Untagged>(fallback).is_some());
+    REQUIRE(crab::ref::cast<Untagged>(node).is_none());
+
+    REQUIRE(crab::ref::dynamic_downcast<Literal>(static_cast<Node*>(nullptr)) == nullptr);
+  }
+
+  SECTION("Owning Types") {
+    Box<Node> boxed{crab::make_box<Add>()};
+    REQUIRE(boxed.downcast<Binary>().is_some());
+    REQUIRE(boxed.downcast<Literal>().is_none());
+    REQUIRE(crab::fn::cast<Add>(boxed).is_some());
+
+    REQUIRE(std::move(boxed).downcast_lossy<Add>().is_some());
+
+    Rc<Node> shared{crab::make_rc<Literal>(4)};
+    REQUIRE(shared.downcast<Literal>().is_some());
+    REQUIRE(shared.downcast<Add>().is_none());
+    REQUIRE(crab::fn::cast<Literal>(shared).get()->value == 4);
+  }
+}
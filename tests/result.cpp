@@ -158,4 +158,56 @@ TEST_CASE("Result", "[result]") {
       CHECK(b.is_err_and([](StringView err) { return err == "what"; }));
     }
   }
+
+  SECTION("Tag kept in a niche") {
+    Result<Option<u64>, u32> option{crab::err<u32>(7)};
+    STATIC_CHECK(sizeof(option) == sizeof(Option<u64>));
+
+    REQUIRE(option.is_err());
+    REQUIRE(option.get_err() == 7);
+
+    option = Option<u64>{};
+    REQUIRE(option.is_ok());
+    REQUIRE(option.get().is_none());
+
+    option = Option<u64>{42};
+    const Result<Option<u64>, u32> copy{option};
+    REQUIRE(copy.get().get() == 42);
+
+    option = 8_u32;
+    REQUIRE(option.get_err() == 8);
+    REQUIRE(copy.is_ok());
+  }
+
+  SECTION("Reading a moved-from result") {
+    // a null box is both a moved-from Box & the niche of Box, so this keeps a separate tag
+    Result<Box<i32>, crab::unit> boxed{crab::make_box<i32>(20)};
+    Result<Box<i32>, crab::unit> moved{crab::move(boxed)};
+    REQUIRE_FALSE(boxed.is_valid());
+    REQUIRE(moved.is_ok());
+    REQUIRE(*moved.get() == 20);
+
+    const Box<i32> value{crab::move(moved).unwrap()};
+    REQUIRE(*value == 20);
+    REQUIRE_FALSE(moved.is_valid());
+
+    Result<u64, crab::AnyError> any{crab::AnyError{Error{}}};
+    const Result<u64, crab::AnyError> moved_any{crab::move(any)};
+    REQUIRE_FALSE(any.is_valid());
+    REQUIRE(moved_any.is_err());
+
+    // niched results are trivially copyable, so moving out of one leaves it as it was
+    Result<Option<u64>, u32> option{Option<u64>{42}};
+    const Option<u64> taken{crab::move(option).unwrap()};
+    REQUIRE(taken.get() == 42);
+    REQUIRE(option.is_valid());
+    REQUIRE(option.is_ok());
+    REQUIRE(option.get().get() == 42);
+
+    option = 8_u32;
+    const u32 error{crab::move(option).unwrap_err()};
+    REQUIRE(error == 8);
+    REQUIRE(option.is_err());
+    REQUIRE(option.get_err() == 8);
+  }
 }
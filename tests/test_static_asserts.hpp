@@ -2,6 +2,7 @@
 
 #include <catch2/catch_test_macros.hpp>
 #include <concepts>
+#include <memory>
 #include <crab/preamble.hpp>
 #include <utility>
 
@@ -30,3 +31,103 @@ namespace asserts {
   }
 
 };
+
+namespace asserts {
+  /// Whether an Option<T> is trivial in the same ways as T is
+  template<typename T>
+  constexpr bool option_trivial_as{
+    std::is_trivially_copyable_v<Option<T>> == std::is_trivially_copyable_v<T>
+    and std::is_trivially_copy_constructible_v<Option<T>> == std::is_trivially_copy_constructible_v<T>
+    and std::is_trivially_move_constructible_v<Option<T>> == std::is_trivially_move_constructible_v<T>
+    and std::is_trivially_destructible_v<Option<T>> == std::is_trivially_destructible_v<T>
+  };
+
+  static_assert(std::is_trivially_copyable_v<Option<i32>>);
+  static_assert(std::is_trivially_copyable_v<Option<u64>>);
+  static_assert(std::is_trivially_copyable_v<Option<f32>>);
+  static_assert(std::is_trivially_copyable_v<Option<bool>>);
+  static_assert(std::is_trivially_copyable_v<Option<Option<i32>>>);
+  static_assert(std::is_trivially_copyable_v<Option<i32&>>);
+  static_assert(std::is_trivially_copyable_v<Option<const i32&>>);
+  static_assert(std::is_trivially_copyable_v<Option<crab::unit>>);
+  static_assert(std::is_trivially_copyable_v<Option<std::array<u8, 3>>>);
+
+  static_assert(not std::is_trivially_copyable_v<Option<String>>);
+  static_assert(not std::is_trivially_destructible_v<Option<String>>);
+  static_assert(std::is_copy_constructible_v<Option<String>>);
+
+  static_assert(option_trivial_as<i32>);
+  static_assert(option_trivial_as<String>);
+  static_assert(option_trivial_as<std::unique_ptr<i32>>);
+  static_assert(option_trivial_as<Option<i32>>);
+  static_assert(option_trivial_as<std::pair<i32, f32>>);
+}
+
+namespace asserts {
+  /// Small error type like a parser would return
+  struct ParseError {
+    u32 offset;
+    u16 code;
+  };
+
+  static_assert(std::is_trivially_copyable_v<AnyOf<i32, f32>>);
+  static_assert(std::is_trivially_move_constructible_v<AnyOf<u64, const i32&>>);
+  static_assert(std::is_trivially_copyable_v<Result<u32, ParseError>>);
+  static_assert(std::is_trivially_copyable_v<Result<i32, crab::unit>>);
+
+  static_assert(not std::is_trivially_copyable_v<AnyOf<i32, String>>);
+  static_assert(not std::is_trivially_destructible_v<Result<i32, String>>);
+  static_assert(not std::is_trivially_copyable_v<Result<i32, std::unique_ptr<i32>>>);
+  static_assert(std::is_trivially_move_constructible_v<AnyOf<std::array<u8, 4>, i64>>);
+
+  // trivially copyable types of at most two eightbytes are returned in registers under the Itanium / SysV ABI
+  static_assert(sizeof(Result<u32, ParseError>) <= 2 * sizeof(u64));
+
+  /// Status code with an unused value, like most error enums
+  enum class StatusCode : u16 { Timeout, Refused, Reset };
+}
+
+template<>
+struct crab::opt::Niche<asserts::StatusCode> : ValueNiche<asserts::StatusCode, asserts::StatusCode{0xFFFF}> {};
+
+namespace asserts {
+  // the tag of a result is kept in a niche of either side, when the other side fits around it
+  static_assert(sizeof(Result<crab::unit, StatusCode>) == sizeof(StatusCode));
+  static_assert(sizeof(Result<crab::unit, bool>) == sizeof(bool));
+  static_assert(sizeof(Result<f32, crab::unit>) == sizeof(f32));
+  static_assert(sizeof(Result<Ref<i32>, crab::unit>) == sizeof(Ref<i32>));
+  static_assert(sizeof(Result<Option<u64>, u32>) == sizeof(Option<u64>));
+  static_assert(sizeof(Result<u32, Option<u64>>) == sizeof(Option<u64>));
+  static_assert(sizeof(Result<AnyOf<u32, f32>, StatusCode>) == sizeof(AnyOf<u32, f32>));
+  static_assert(sizeof(Result<Option<u32>, StatusCode>) == sizeof(Option<u32>));
+  static_assert(sizeof(Result<Result<crab::unit, StatusCode>, u8>) == 2 * sizeof(StatusCode));
+
+  // niched results are trivially copyable
+  static_assert(std::is_trivially_copyable_v<Result<crab::unit, StatusCode>>);
+  static_assert(std::is_trivially_copyable_v<Result<Option<u64>, u32>>);
+
+  // sides with no niche (or no room around it) keep a separate tag, as do sides that are not trivially copyable, whose
+  // moved-from value may be their niche (eg. a null Box)
+  static_assert(sizeof(Result<u64, StatusCode>) == 2 * sizeof(u64));
+  static_assert(sizeof(Result<Box<i32>, StatusCode>) == 2 * sizeof(Box<i32>));
+  static_assert(sizeof(Result<Box<i32>, crab::unit>) > sizeof(Box<i32>));
+  static_assert(sizeof(Result<Option<String>, crab::unit>) > sizeof(Option<String>));
+  static_assert(not std::is_copy_constructible_v<Result<Box<i32>, crab::unit>>);
+  static_assert(sizeof(Result<crab::unit, u32>) == 2 * sizeof(u32));
+
+  // error codes are trivial, and leave room for a small Ok value around their category
+  static_assert(std::is_trivially_copyable_v<ErrorCode>);
+  static_assert(sizeof(Option<ErrorCode>) == sizeof(ErrorCode));
+  static_assert(sizeof(Result<u32, ErrorCode>) == sizeof(ErrorCode));
+  static_assert(std::is_trivially_copyable_v<Result<u32, ErrorCode>>);
+
+  // any error keeps its box's niche for options, but results of it keep a separate tag
+  static_assert(sizeof(Option<InlineBox<i32, 16>>) == sizeof(InlineBox<i32, 16>));
+  static_assert(sizeof(Option<AnyError>) == sizeof(AnyError));
+  static_assert(sizeof(Result<u64, AnyError>) > sizeof(AnyError));
+
+  // context frames keep the niche & triviality of the error they are added to
+  static_assert(std::is_trivially_copyable_v<ContextError<ErrorCode>>);
+  static_assert(sizeof(Result<u32, ContextError<ErrorCode>>) == sizeof(ContextError<ErrorCode>));
+  static_assert(sizeof(Option<ContextError<ErrorCode>>) == sizeof(ContextError<ErrorCode>));
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <utility>
 #include <crab/preamble.hpp>
 #include <crab/ref/ref.hpp>
@@ -186,6 +187,46 @@ struct Derived final : public Base {
   }
 };
 
+/// Number of live allocations made by a CountingAllocator (and any of its copies / rebinds)
+struct AllocationCount {
+  usize allocations{0};
+  usize deallocations{0};
+
+  [[nodiscard]] auto live() const -> usize {
+    return allocations - deallocations;
+  }
+};
+
+/**
+ * @brief Stateful standard allocator that counts every allocation it makes
+ */
+template<typename T>
+struct CountingAllocator {
+  using value_type = T;
+
+  explicit CountingAllocator(AllocationCount& count): count{&count} {}
+
+  template<typename U>
+  CountingAllocator(const CountingAllocator<U>& other): count{other.count} {}
+
+  [[nodiscard]] auto allocate(const usize length) -> T* {
+    count->allocations++;
+    return std::allocator<T>{}.allocate(length);
+  }
+
+  auto deallocate(T* const ptr, const usize length) -> void {
+    count->deallocations++;
+    std::allocator<T>{}.deallocate(ptr, length);
+  }
+
+  template<typename U>
+  [[nodiscard]] auto operator==(const CountingAllocator<U>& other) const -> bool {
+    return count == other.count;
+  }
+
+  AllocationCount* count;
+};
+
 constexpr auto test_values = []<typename... T>(const auto& test, T&&... types) {
   const auto test_wrapped = [test]<typename S>(S&& x) {
     test(std::forward<S>(x));